@@ -1,4 +1,4 @@
-QT       += core gui webenginewidgets network
+QT       += core gui webenginewidgets webchannel network concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets webenginewidgets
 
@@ -17,14 +17,23 @@ SOURCES += \
     widgets/questionpreviewwidget.cpp \
     widgets/ptaassistcontroller.cpp \
     core/questionmanager.cpp \
+    core/answerstore.cpp \
+    core/sessionjournal.cpp \
+    core/sessionsnapshot.cpp \
     core/configmanager.cpp \
     core/practicemanager.cpp \
     core/wronganswerset.cpp \
     models/question.cpp \
     models/questionbank.cpp \
+    models/questionlistmodel.cpp \
     utils/jsonutils.cpp \
     utils/bankscanner.cpp \
+    utils/bankwatcher.cpp \
     utils/markdownrenderer.cpp \
+    utils/markdownrendererpool.cpp \
+    utils/markdowntokenizer.cpp \
+    utils/mathprerenderer.cpp \
+    utils/resourceschemehandler.cpp \
     utils/textnormalize.cpp \
     utils/questionsearchindex.cpp
 
@@ -40,14 +49,23 @@ HEADERS += \
     widgets/questionpreviewwidget.h \
     widgets/ptaassistcontroller.h \
     core/questionmanager.h \
+    core/answerstore.h \
+    core/sessionjournal.h \
+    core/sessionsnapshot.h \
     core/configmanager.h \
     core/practicemanager.h \
     core/wronganswerset.h \
     models/question.h \
     models/questionbank.h \
+    models/questionlistmodel.h \
     utils/jsonutils.h \
     utils/bankscanner.h \
+    utils/bankwatcher.h \
     utils/markdownrenderer.h \
+    utils/markdownrendererpool.h \
+    utils/markdowntokenizer.h \
+    utils/mathprerenderer.h \
+    utils/resourceschemehandler.h \
     utils/textnormalize.h \
     utils/questionsearchindex.h
 
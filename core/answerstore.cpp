@@ -0,0 +1,104 @@
+#include "answerstore.h"
+
+AnswerStore::AnswerStore()
+    : m_answeredCount(0)
+{
+}
+
+void AnswerStore::resize(int count)
+{
+    clear();
+    const int size = qMax(0, count);
+    m_answered.resize(size);
+    m_correct.resize(size);
+    m_answerIds.fill(-1, size);
+}
+
+void AnswerStore::clear()
+{
+    m_answered.clear();
+    m_correct.clear();
+    m_answeredCount = 0;
+    m_answerIds.clear();
+    m_pool.clear();
+    m_poolIndex.clear();
+    m_multiAnswers.clear();
+}
+
+bool AnswerStore::isAnswered(int index) const
+{
+    return isValidIndex(index) && m_answered.testBit(index);
+}
+
+void AnswerStore::setAnswered(int index, bool answered)
+{
+    if (!isValidIndex(index) || m_answered.testBit(index) == answered) {
+        return;
+    }
+    m_answered.setBit(index, answered);
+    m_answeredCount += answered ? 1 : -1;
+}
+
+bool AnswerStore::isCorrect(int index) const
+{
+    return isValidIndex(index) && m_correct.testBit(index);
+}
+
+void AnswerStore::setCorrect(int index, bool correct)
+{
+    if (isValidIndex(index)) {
+        m_correct.setBit(index, correct);
+    }
+}
+
+QString AnswerStore::answer(int index) const
+{
+    if (!isValidIndex(index)) {
+        return QString();
+    }
+    const int id = m_answerIds[index];
+    return id >= 0 ? m_pool[id] : QString();
+}
+
+void AnswerStore::setAnswer(int index, const QString &answer)
+{
+    if (isValidIndex(index)) {
+        m_answerIds[index] = answer.isEmpty() ? -1 : intern(answer);
+    }
+}
+
+QStringList AnswerStore::multiAnswers(int index) const
+{
+    return m_multiAnswers.value(index);
+}
+
+void AnswerStore::setMultiAnswers(int index, const QStringList &answers)
+{
+    if (!isValidIndex(index)) {
+        return;
+    }
+    if (answers.isEmpty()) {
+        m_multiAnswers.remove(index);
+        return;
+    }
+
+    // 填空答案同样经过字符串池，相同的答案共享同一份数据
+    QStringList pooled;
+    pooled.reserve(answers.size());
+    for (const QString &answer : answers) {
+        pooled.append(answer.isEmpty() ? QString() : m_pool[intern(answer)]);
+    }
+    m_multiAnswers.insert(index, pooled);
+}
+
+int AnswerStore::intern(const QString &value)
+{
+    auto it = m_poolIndex.constFind(value);
+    if (it != m_poolIndex.constEnd()) {
+        return it.value();
+    }
+    const int id = m_pool.size();
+    m_pool.append(value);
+    m_poolIndex.insert(value, id);
+    return id;
+}
@@ -0,0 +1,56 @@
+#ifndef ANSWERSTORE_H
+#define ANSWERSTORE_H
+
+#include <QBitArray>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// 练习会话的作答状态存储（按列组织）
+// - 已答/答对状态使用位图，已答数量随状态翻转同步维护，查询为O(1)
+// - 单选/判断答案大多是"A"、"T"这类短字符串，统一放入字符串池，每题只保存池下标
+// - 填空题的多答案只为实际作答过的题目保存
+class AnswerStore
+{
+public:
+    AnswerStore();
+
+    // 重新分配容量并清空所有作答状态
+    void resize(int count);
+    void clear();
+    int size() const { return m_answered.size(); }
+
+    // Answered state
+    bool isAnswered(int index) const;
+    void setAnswered(int index, bool answered);
+    int answeredCount() const { return m_answeredCount; }
+    int unansweredCount() const { return size() - m_answeredCount; }
+
+    // Correct state（由提交时的判题结果写入）
+    bool isCorrect(int index) const;
+    void setCorrect(int index, bool correct);
+
+    // Answers
+    QString answer(int index) const;
+    void setAnswer(int index, const QString &answer);
+    QStringList multiAnswers(int index) const;
+    void setMultiAnswers(int index, const QStringList &answers);
+
+    int pooledStringCount() const { return m_pool.size(); }
+
+private:
+    int intern(const QString &value);
+    bool isValidIndex(int index) const { return index >= 0 && index < size(); }
+
+    QBitArray m_answered;
+    QBitArray m_correct;
+    int m_answeredCount;
+
+    QVector<int> m_answerIds;           // 题目下标 -> 字符串池下标，-1表示未作答
+    QVector<QString> m_pool;            // 去重后的答案字符串
+    QHash<QString, int> m_poolIndex;    // 答案字符串 -> 字符串池下标
+    QHash<int, QStringList> m_multiAnswers; // 题目下标 -> 填空答案
+};
+
+#endif // ANSWERSTORE_H
@@ -1,20 +1,96 @@
 #include "configmanager.h"
 #include "../utils/jsonutils.h"
 #include "../utils/bankscanner.h"
+#include <QCoreApplication>
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
+#include <QHash>
 #include <QJsonArray>
 #include <QDebug>
 
+// 存档中题目内容哈希保留的字节数
+static const int kQuestionHashBytes = 8;
+
+// 题库选择和存档各自的文件，与config.json位于同一目录
+static const char *const kBanksFile = "banks.json";
+static const char *const kCheckpointFile = "checkpoint.json";
+
+// 延迟保存的等待时间
+static const int kSaveDelayMs = 500;
+
+static QByteArray questionRefHash(const Question &question)
+{
+    return question.contentHash().left(kQuestionHashBytes);
+}
+
+// 以扫描结果为准更新题库列表与题目数量，保留配置中同一src题库的选择状态
+static QVector<QuestionBankInfo> mergeBankList(const QVector<QuestionBankInfo> &configBanks,
+                                               const QVector<QuestionBankInfo> &scannedBanks)
+{
+    QHash<QString, const QuestionBankInfo *> configBySrc;
+    configBySrc.reserve(configBanks.size());
+    for (const QuestionBankInfo &configInfo : configBanks) {
+        // 与原先的顺序查找一致，src重复时以第一项为准
+        if (!configBySrc.contains(configInfo.src)) {
+            configBySrc.insert(configInfo.src, &configInfo);
+        }
+    }
+    
+    QVector<QuestionBankInfo> mergedBanks;
+    mergedBanks.reserve(scannedBanks.size());
+    for (const QuestionBankInfo &scannedInfo : scannedBanks) {
+        QuestionBankInfo mergedInfo = scannedInfo;
+        const QuestionBankInfo *configInfo = configBySrc.value(scannedInfo.src, nullptr);
+        if (configInfo) {
+            mergedInfo.chosen = configInfo->chosen;
+            mergedInfo.chosennum = qMin(configInfo->chosennum, scannedInfo.size); // 确保不超过实际题目数
+        }
+        mergedBanks.append(mergedInfo);
+    }
+    return mergedBanks;
+}
+
 ConfigManager::ConfigManager()
 {
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(kSaveDelayMs);
+    QObject::connect(&m_saveTimer, &QTimer::timeout, &m_saveTimer, [this]() {
+        if (!saveConfig()) {
+            qWarning() << "Failed to save config:" << m_lastError;
+        }
+    });
+    // 程序退出时ConfigManager不一定被析构，退出前写入尚未保存的修改
+    if (QCoreApplication::instance()) {
+        QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, &m_saveTimer, [this]() {
+            if (m_dirtyStores != 0) {
+                saveConfig();
+            }
+        });
+    }
+    
     // 程序启动时自动加载配置文件
     initializeConfig();
 }
 
+ConfigManager::~ConfigManager()
+{
+    if (m_dirtyStores != 0) {
+        saveConfig();
+    }
+}
+
 bool ConfigManager::loadConfig(const QString &configPath)
 {
     m_lastError.clear();
+    m_configPath = configPath;
+    m_questionBanks.clear();
+    m_subjectPaths.clear();
+    m_checkpoint = CheckpointData();
+    m_banksLoaded = false;
+    m_checkpointLoaded = false;
+    m_dirtyStores = 0;
+    m_legacyConfigPending = false;
     
     QJsonObject config = JsonUtils::loadJsonFromFile(configPath);
     if (config.isEmpty()) {
@@ -22,6 +98,104 @@ bool ConfigManager::loadConfig(const QString &configPath)
         return false;
     }
 
+    parseSettings(config);
+    
+    // 旧版本的config.json同时保存题库选择和存档，拆分到各自的文件后重写config.json
+    if (config.contains("QuestionBank") || config.contains("last_checkpoint")) {
+        QJsonObject legacy;
+        if (!QFileInfo::exists(storePath(kBanksFile))) {
+            legacy["QuestionBank"] = config["QuestionBank"];
+        }
+        if (!QFileInfo::exists(storePath(kCheckpointFile))) {
+            legacy["last_checkpoint"] = config["last_checkpoint"];
+        }
+        importStores(legacy);
+        m_dirtyStores |= SettingsStore;
+        m_legacyConfigPending = true;
+        qDebug() << "Migrating question banks and checkpoint out of" << configPath;
+        if (!saveConfig()) {
+            qWarning() << "Failed to migrate config:" << m_lastError;
+        }
+    }
+    
+    return true;
+}
+
+bool ConfigManager::saveConfig()
+{
+    m_lastError.clear();
+    m_saveTimer.stop();
+    
+    bool success = true;
+    
+    if (m_dirtyStores & BanksStore) {
+        if (JsonUtils::saveJsonToFile(questionBanksToJson(), storePath(kBanksFile))) {
+            m_dirtyStores &= ~BanksStore;
+        } else {
+            m_lastError = JsonUtils::getLastError();
+            success = false;
+        }
+    }
+    
+    if (m_dirtyStores & CheckpointStore) {
+        if (saveCheckpointStore()) {
+            m_dirtyStores &= ~CheckpointStore;
+        } else {
+            success = false;
+        }
+    }
+    
+    // 旧版config.json中还有题库选择和存档时，必须等它们写入各自的文件后才能重写，
+    // 否则中途失败会丢失这些数据；未迁移完成时保留旧文件，下次启动重新迁移
+    if ((m_dirtyStores & SettingsStore)
+        && !(m_legacyConfigPending && (m_dirtyStores & (BanksStore | CheckpointStore)))) {
+        if (JsonUtils::saveJsonToFile(settingsToJson(), m_configPath)) {
+            m_dirtyStores &= ~SettingsStore;
+            m_legacyConfigPending = false;
+        } else {
+            m_lastError = JsonUtils::getLastError();
+            success = false;
+        }
+    }
+    
+    return success;
+}
+
+void ConfigManager::scheduleSave()
+{
+    if (m_dirtyStores != 0) {
+        m_saveTimer.start();
+    }
+}
+
+bool ConfigManager::saveCheckpointStore()
+{
+    const QString path = storePath(kCheckpointFile);
+    if (!hasCheckpoint()) {
+        QFile::remove(checkpointContentPath());
+        m_checkpointContentSession.clear();
+        if (QFileInfo::exists(path) && !QFile::remove(path)) {
+            m_lastError = QString("Cannot remove checkpoint file: %1").arg(path);
+            return false;
+        }
+        return true;
+    }
+    
+    prepareCheckpointForSave();
+    if (!JsonUtils::saveJsonToFile(checkpointToJson(), path)) {
+        m_lastError = JsonUtils::getLastError();
+        return false;
+    }
+    return true;
+}
+
+QString ConfigManager::storePath(const QString &fileName) const
+{
+    return QFileInfo(m_configPath).absoluteDir().filePath(fileName);
+}
+
+void ConfigManager::parseSettings(const QJsonObject &config)
+{
     if (config.contains("ShuffleQuestions")) {
         m_shuffleQuestionsEnabled = config["ShuffleQuestions"].toBool(true);
     } else {
@@ -40,28 +214,16 @@ bool ConfigManager::loadConfig(const QString &configPath)
         }
     }
     
+    m_rendererPoolSize = qBound(0, config.value("RendererPoolSize").toInt(6), 32);
+    
     // Load current subject
     if (config.contains("Subject")) {
         m_currentSubject = config["Subject"].toString();
     }
-    
-    // Load question banks
-    if (config.contains("QuestionBank")) {
-        parseQuestionBanks(config["QuestionBank"].toObject());
-    }
-    
-    // Load checkpoint if exists
-    if (config.contains("last_checkpoint")) {
-        parseCheckpoint(config["last_checkpoint"].toObject());
-    }
-    
-    return true;
 }
 
-bool ConfigManager::saveConfig(const QString &configPath)
+QJsonObject ConfigManager::settingsToJson() const
 {
-    m_lastError.clear();
-    
     QJsonObject config;
     config["Subject"] = m_currentSubject;
     config["ShuffleQuestions"] = m_shuffleQuestionsEnabled;
@@ -70,60 +232,141 @@ bool ConfigManager::saveConfig(const QString &configPath)
     assistant["SearchTopK"] = m_assistantSearchTopK;
     assistant["AutoThreshold"] = m_assistantAutoThreshold;
     config["Assistant"] = assistant;
+    config["RendererPoolSize"] = m_rendererPoolSize;
     
-    // Save question banks
-    config["QuestionBank"] = questionBanksToJson();
-    
-    // Save checkpoint if exists
-    if (hasCheckpoint()) {
-        config["last_checkpoint"] = checkpointToJson();
+    return config;
+}
+
+void ConfigManager::importStores(const QJsonObject &config)
+{
+    // 题库选择和存档直接取自给定的JSON，不再从各自的文件读取
+    if (config["QuestionBank"].isObject()) {
+        parseQuestionBanks(config["QuestionBank"].toObject());
+        m_banksLoaded = true;
+        m_dirtyStores |= BanksStore;
+    }
+    if (config["last_checkpoint"].isObject()) {
+        parseCheckpoint(config["last_checkpoint"].toObject());
+        m_checkpointLoaded = true;
+        m_dirtyStores |= CheckpointStore;
+    }
+}
+
+void ConfigManager::ensureBanksLoaded() const
+{
+    if (!m_banksLoaded) {
+        // 惰性加载不改变对外可见的状态
+        const_cast<ConfigManager *>(this)->loadBanksStore();
+    }
+}
+
+void ConfigManager::ensureCheckpointLoaded() const
+{
+    if (!m_checkpointLoaded) {
+        const_cast<ConfigManager *>(this)->loadCheckpointStore();
+    }
+}
+
+void ConfigManager::loadBanksStore()
+{
+    m_banksLoaded = true;
+    const QString path = storePath(kBanksFile);
+    if (!QFileInfo::exists(path)) {
+        return;
     }
     
-    bool success = JsonUtils::saveJsonToFile(config, configPath);
-    if (!success) {
-        m_lastError = JsonUtils::getLastError();
+    const QJsonObject json = JsonUtils::loadJsonFromFile(path);
+    if (json.isEmpty()) {
+        qWarning() << "Failed to load question bank selections:" << JsonUtils::getLastError();
+        return;
+    }
+    parseQuestionBanks(json);
+}
+
+void ConfigManager::loadCheckpointStore()
+{
+    m_checkpointLoaded = true;
+    const QString path = storePath(kCheckpointFile);
+    if (!QFileInfo::exists(path)) {
+        return;
     }
     
-    return success;
+    const QJsonObject json = JsonUtils::loadJsonFromFile(path);
+    if (json.isEmpty()) {
+        qWarning() << "Failed to load checkpoint:" << JsonUtils::getLastError();
+        return;
+    }
+    parseCheckpoint(json);
+}
+
+void ConfigManager::setCurrentSubject(const QString &subject)
+{
+    if (m_currentSubject != subject) {
+        m_currentSubject = subject;
+        m_dirtyStores |= SettingsStore;
+    }
 }
 
 QStringList ConfigManager::getAvailableSubjects() const
 {
+    ensureBanksLoaded();
     return m_questionBanks.keys();
 }
 
 QuestionBank ConfigManager::getQuestionBank(const QString &subject) const
 {
+    ensureBanksLoaded();
     return m_questionBanks.value(subject, QuestionBank());
 }
 
 void ConfigManager::setQuestionBank(const QString &subject, const QuestionBank &bank)
 {
+    ensureBanksLoaded();
     m_questionBanks[subject] = bank;
+    m_dirtyStores |= BanksStore;
 }
 
 bool ConfigManager::hasQuestionBank(const QString &subject) const
 {
+    ensureBanksLoaded();
     return m_questionBanks.contains(subject);
 }
 
 bool ConfigManager::hasCheckpoint() const
 {
+    ensureCheckpointLoaded();
     return m_checkpoint.trueOrFalseCheck > 0 || 
            m_checkpoint.choiceCheck > 0 || 
            m_checkpoint.fillBlankCheck > 0 ||
            !m_checkpoint.trueOrFalseData.isEmpty() ||
            !m_checkpoint.choiceData.isEmpty() ||
-           !m_checkpoint.fillBlankData.isEmpty();
+           !m_checkpoint.fillBlankData.isEmpty() ||
+           !m_checkpoint.questionRefs.isEmpty();
+}
+
+CheckpointData ConfigManager::getCheckpoint() const
+{
+    ensureCheckpointLoaded();
+    return m_checkpoint;
+}
+
+void ConfigManager::setCheckpoint(const CheckpointData &checkpoint)
+{
+    m_checkpoint = checkpoint;
+    m_checkpointLoaded = true;
+    m_dirtyStores |= CheckpointStore;
 }
 
 void ConfigManager::clearCheckpoint()
 {
     m_checkpoint = CheckpointData();
+    m_checkpointLoaded = true;
+    m_dirtyStores |= CheckpointStore;
 }
 
 void ConfigManager::addSubject(const QString &subject, const QString &path)
 {
+    ensureBanksLoaded();
     // 存储科目路径
     m_subjectPaths[subject] = path;
     
@@ -140,6 +383,7 @@ void ConfigManager::addSubject(const QString &subject, const QString &path)
     }
     
     m_questionBanks[subject] = bank;
+    m_dirtyStores |= BanksStore;
     qDebug() << "Added subject:" << subject << "with" 
              << bank.getChoiceBanks().size() << "choice banks,"
              << bank.getTrueOrFalseBanks().size() << "true/false banks,"
@@ -148,10 +392,12 @@ void ConfigManager::addSubject(const QString &subject, const QString &path)
 
 void ConfigManager::removeSubject(const QString &subject)
 {
+    ensureBanksLoaded();
     m_questionBanks.remove(subject);
     m_subjectPaths.remove(subject); // 同时移除科目路径
+    m_dirtyStores |= BanksStore;
     if (m_currentSubject == subject) {
-        m_currentSubject.clear();
+        setCurrentSubject(QString());
     }
 }
 
@@ -162,16 +408,24 @@ void ConfigManager::refreshSubjectBanks(const QString &subject)
     }
 
     const QString subjectPath = getSubjectPath(subject);
-    QuestionBank configBank = m_questionBanks.value(subject, QuestionBank(subject));
     QuestionBank scannedBank = BankScanner::scanSubjectDirectory(subjectPath, subject);
+    applyScannedBank(subject, scannedBank);
+}
 
+void ConfigManager::applyScannedBank(const QString &subject, const QuestionBank &scannedBank)
+{
+    // 保留用户的选择配置，用扫描结果更新题库列表与题目数量
+    ensureBanksLoaded();
+    QuestionBank configBank = m_questionBanks.value(subject, QuestionBank(subject));
     QuestionBank mergedBank = mergeQuestionBankInfo(configBank, scannedBank, subject);
     m_questionBanks[subject] = mergedBank;
+    m_dirtyStores |= BanksStore;
 }
 
 QString ConfigManager::getSubjectPath(const QString &subject) const
 {
     // 如果存在存储的路径，则返回存储的路径，否则返回默认路径
+    ensureBanksLoaded();
     if (m_subjectPaths.contains(subject)) {
         return m_subjectPaths[subject];
     }
@@ -203,6 +457,16 @@ void ConfigManager::createDefaultConfig()
     m_subjectPaths.clear();
     m_checkpoint = CheckpointData();
     m_shuffleQuestionsEnabled = true;
+    m_rendererPoolSize = 6;
+    m_dirtyStores = SettingsStore;
+    
+    // 只重置设置：config.json缺失或损坏时，已有的题库选择和存档仍按需从各自的文件加载，
+    // 文件不存在的存储才使用默认的空内容
+    m_banksLoaded = !QFileInfo::exists(storePath(kBanksFile));
+    if (m_banksLoaded) {
+        m_dirtyStores |= BanksStore;
+    }
+    m_checkpointLoaded = !QFileInfo::exists(storePath(kCheckpointFile));
     
     // 检查Subject目录下是否有可用的科目
     QDir subjectDir("Subject");
@@ -227,7 +491,17 @@ bool ConfigManager::copyFromReference(const QString &referencePath)
         return false;
     }
     
-    return loadConfig(referencePath);
+    const QJsonObject config = JsonUtils::loadJsonFromFile(referencePath);
+    if (config.isEmpty()) {
+        m_lastError = JsonUtils::getLastError();
+        return false;
+    }
+    
+    // 参考配置中的内容作为修改处理，保存时写入当前的配置文件
+    parseSettings(config);
+    importStores(config);
+    m_dirtyStores |= SettingsStore;
+    return true;
 }
 
 void ConfigManager::initializeConfig()
@@ -251,11 +525,13 @@ void ConfigManager::initializeConfig()
 
 void ConfigManager::createDefaultConfigFile()
 {
+    // 保存到根目录的config.json，其他存储文件与它位于同一目录
+    m_configPath = "config.json";
+    
     // 创建默认配置
     createDefaultConfig();
     
-    // 保存到根目录的config.json
-    if (!saveConfig("config.json")) {
+    if (!saveConfig()) {
         qDebug() << "Failed to create default config.json:" << m_lastError;
     } else {
         qDebug() << "Default config.json created successfully";
@@ -289,14 +565,22 @@ void ConfigManager::parseQuestionBanks(const QJsonObject &json)
         // 先从配置文件加载题库配置信息（保留用户的选择配置）
         QuestionBank configBank(subjectName);
         configBank.fromJson(subjectData);
-        
-        // 实时扫描题库目录，获取最新的题库文件信息
-        QuestionBank scannedBank = BankScanner::scanSubjectDirectory(subjectPath, subjectName);
+        m_questionBanks.insert(subjectName, configBank);
+    }
+    
+    // 实时扫描所有科目的题库目录（并行），获取最新的题库文件信息
+    mergeScannedBanks(BankScanner::scanSubjectDirectories(m_subjectPaths));
+}
+
+void ConfigManager::mergeScannedBanks(const QMap<QString, QuestionBank> &scannedBanks)
+{
+    for (auto it = m_questionBanks.begin(); it != m_questionBanks.end(); ++it) {
+        const QString &subjectName = it.key();
         
         // 合并配置信息和实时扫描信息
-        QuestionBank mergedBank = mergeQuestionBankInfo(configBank, scannedBank, subjectName);
+        QuestionBank mergedBank = mergeQuestionBankInfo(it.value(), scannedBanks.value(subjectName, QuestionBank(subjectName)), subjectName);
         
-        m_questionBanks[subjectName] = mergedBank;
+        it.value() = mergedBank;
         qDebug() << "Loaded subject:" << subjectName << "with" 
                  << mergedBank.getChoiceBanks().size() << "choice banks,"
                  << mergedBank.getTrueOrFalseBanks().size() << "true/false banks,"
@@ -327,6 +611,22 @@ QJsonObject ConfigManager::questionBanksToJson() const
 void ConfigManager::parseCheckpoint(const QJsonObject &json)
 {
     m_checkpoint = CheckpointData();
+    m_checkpoint.sessionId = json["session_id"].toString();
+    
+    // 新格式：题目引用
+    if (json.contains("QuestionRefs") && json["QuestionRefs"].isArray()) {
+        const QJsonArray refsArray = json["QuestionRefs"].toArray();
+        m_checkpoint.questionRefs.reserve(refsArray.size());
+        for (const QJsonValue &value : refsArray) {
+            const QJsonObject refObj = value.toObject();
+            CheckpointQuestionRef ref;
+            ref.bank = refObj["src"].toString();
+            ref.type = Question::stringToType(refObj["type"].toString());
+            ref.index = refObj["i"].toInt(-1);
+            ref.hash = QByteArray::fromHex(refObj["h"].toString().toLatin1());
+            m_checkpoint.questionRefs.append(ref);
+        }
+    }
     
     // Parse TrueOrFalse checkpoint
     if (json.contains("TrueorFalse") && json["TrueorFalse"].isObject()) {
@@ -480,12 +780,6 @@ QJsonObject ConfigManager::checkpointToJson() const
     }
     tfObj["order"] = tfOrderArray;
     
-    QJsonArray tfDataArray;
-    for (const Question &question : m_checkpoint.trueOrFalseData) {
-        tfDataArray.append(question.toJson());
-    }
-    tfObj["data"] = tfDataArray;
-    
     json["TrueorFalse"] = tfObj;
     
     // Choice checkpoint
@@ -498,12 +792,6 @@ QJsonObject ConfigManager::checkpointToJson() const
     }
     choiceObj["order"] = choiceOrderArray;
     
-    QJsonArray choiceDataArray;
-    for (const Question &question : m_checkpoint.choiceData) {
-        choiceDataArray.append(question.toJson());
-    }
-    choiceObj["data"] = choiceDataArray;
-    
     json["Choice"] = choiceObj;
     
     // FillBlank checkpoint
@@ -516,23 +804,22 @@ QJsonObject ConfigManager::checkpointToJson() const
     }
     fbObj["order"] = fbOrderArray;
     
-    QJsonArray fbDataArray;
-    for (const Question &question : m_checkpoint.fillBlankData) {
-        fbDataArray.append(question.toJson());
-    }
-    fbObj["data"] = fbDataArray;
-    
     json["FillBlank"] = fbObj;
     
-    // Wrong answers
-    QJsonObject waObj;
-    QJsonArray waDataArray;
-    for (const Question &question : m_checkpoint.wrongAnswers) {
-        waDataArray.append(question.toJson());
+    // 题目只保存引用，内容由prepareCheckpointForSave写入单独的文件；
+    // 错题列表恢复时由答题状态重建，不再保存
+    QJsonArray refsArray;
+    for (const CheckpointQuestionRef &ref : m_checkpoint.questionRefs) {
+        QJsonObject refObj;
+        if (!ref.bank.isEmpty()) {
+            refObj["src"] = ref.bank;
+            refObj["type"] = Question::typeToString(ref.type);
+            refObj["i"] = ref.index;
+        }
+        refObj["h"] = QString::fromLatin1(ref.hash.toHex());
+        refsArray.append(refObj);
     }
-    waObj["data"] = waDataArray;
-    
-    json["WA"] = waObj;
+    json["QuestionRefs"] = refsArray;
     
     // 保存答题状态数据
     QJsonObject statusObj;
@@ -575,75 +862,143 @@ QJsonObject ConfigManager::checkpointToJson() const
     
     json["AnswerStatus"] = statusObj;
     
+    if (!m_checkpoint.sessionId.isEmpty()) {
+        json["session_id"] = m_checkpoint.sessionId;
+    }
+    
     return json;
 }
 
-QuestionBank ConfigManager::mergeQuestionBankInfo(const QuestionBank &configBank, const QuestionBank &scannedBank, const QString &subjectName) const
+QList<Question> ConfigManager::checkpointQuestions() const
 {
-    QuestionBank mergedBank(subjectName);
-    
-    // 合并选择题题库
-    QVector<QuestionBankInfo> mergedChoiceBanks;
-    auto configChoiceBanks = configBank.getChoiceBanks();
-    auto scannedChoiceBanks = scannedBank.getChoiceBanks();
+    QList<Question> questions;
+    questions.append(m_checkpoint.trueOrFalseData);
+    questions.append(m_checkpoint.choiceData);
+    questions.append(m_checkpoint.fillBlankData);
+    return questions;
+}
+
+QString ConfigManager::checkpointContentPath() const
+{
+    return storePath("checkpoint_questions.json");
+}
+
+void ConfigManager::prepareCheckpointForSave()
+{
+    // 从新格式存档加载且尚未恢复时内存中没有题目，引用和内容文件都已在磁盘上
+    const QList<Question> questions = checkpointQuestions();
+    if (questions.isEmpty()) {
+        return;
+    }
     
-    for (const auto &scannedBank : scannedChoiceBanks) {
-        QuestionBankInfo mergedInfo = scannedBank;
-        
-        // 查找配置文件中对应的题库信息
-        for (const auto &configInfo : configChoiceBanks) {
-            if (configInfo.src == scannedBank.src) {
-                // 保留用户配置信息，更新实际题目数量
-                mergedInfo.chosen = configInfo.chosen;
-                mergedInfo.chosennum = qMin(configInfo.chosennum, scannedBank.size); // 确保不超过实际题目数
-                break;
+    if (m_checkpoint.questionRefs.size() != questions.size()) {
+        m_checkpoint.questionRefs.clear();
+        m_checkpoint.questionRefs.reserve(questions.size());
+        for (const Question &question : questions) {
+            CheckpointQuestionRef ref;
+            if (question.hasSource()) {
+                ref.bank = question.getSourceBank();
+                ref.type = question.getType();
+                ref.index = question.getSourceIndex();
             }
+            ref.hash = questionRefHash(question);
+            m_checkpoint.questionRefs.append(ref);
         }
-        mergedChoiceBanks.append(mergedInfo);
     }
-    mergedBank.setChoiceBanks(mergedChoiceBanks);
     
-    // 合并判断题题库
-    QVector<QuestionBankInfo> mergedTrueOrFalseBanks;
-    auto configTrueOrFalseBanks = configBank.getTrueOrFalseBanks();
-    auto scannedTrueOrFalseBanks = scannedBank.getTrueOrFalseBanks();
+    // 题目内容备份，同一会话只写一次
+    if (!m_checkpoint.sessionId.isEmpty() && m_checkpoint.sessionId == m_checkpointContentSession) {
+        return;
+    }
     
-    for (const auto &scannedBank : scannedTrueOrFalseBanks) {
-        QuestionBankInfo mergedInfo = scannedBank;
-        
-        // 查找配置文件中对应的题库信息
-        for (const auto &configInfo : configTrueOrFalseBanks) {
-            if (configInfo.src == scannedBank.src) {
-                // 保留用户配置信息，更新实际题目数量
-                mergedInfo.chosen = configInfo.chosen;
-                mergedInfo.chosennum = qMin(configInfo.chosennum, scannedBank.size); // 确保不超过实际题目数
-                break;
-            }
+    // 有来源的题目按引用从题库加载，只备份不来自题库的题目（如错题复习），按题目位置保存
+    QJsonObject dataObj;
+    for (int i = 0; i < questions.size(); ++i) {
+        if (!questions[i].hasSource()) {
+            dataObj[QString::number(i)] = questions[i].toJson();
         }
-        mergedTrueOrFalseBanks.append(mergedInfo);
     }
-    mergedBank.setTrueOrFalseBanks(mergedTrueOrFalseBanks);
+    QJsonObject content;
+    content["session_id"] = m_checkpoint.sessionId;
+    content["data"] = dataObj;
+    if (JsonUtils::saveJsonToFile(content, checkpointContentPath())) {
+        m_checkpointContentSession = m_checkpoint.sessionId;
+    } else {
+        qWarning() << "Failed to save checkpoint questions:" << JsonUtils::getLastError();
+    }
+}
+
+QList<Question> ConfigManager::loadCheckpointQuestions(const QString &subjectPath) const
+{
+    ensureCheckpointLoaded();
+    QList<Question> questions = checkpointQuestions();
+    if (!questions.isEmpty() || m_checkpoint.questionRefs.isEmpty()) {
+        return questions;
+    }
     
-    // 合并填空题题库
-    QVector<QuestionBankInfo> mergedFillBlankBanks;
-    auto configFillBlankBanks = configBank.getFillBlankBanks();
-    auto scannedFillBlankBanks = scannedBank.getFillBlankBanks();
+    // 每个题库文件只加载一次，按题目在文件中的位置查找
+    QHash<QString, QHash<int, Question>> banks;
+    QHash<int, Question> backup;
+    bool backupLoaded = false;
     
-    for (const auto &scannedBank : scannedFillBlankBanks) {
-        QuestionBankInfo mergedInfo = scannedBank;
+    questions.reserve(m_checkpoint.questionRefs.size());
+    for (int i = 0; i < m_checkpoint.questionRefs.size(); ++i) {
+        const CheckpointQuestionRef &ref = m_checkpoint.questionRefs[i];
         
-        // 查找配置文件中对应的题库信息
-        for (const auto &configInfo : configFillBlankBanks) {
-            if (configInfo.src == scannedBank.src) {
-                // 保留用户配置信息，更新实际题目数量
-                mergedInfo.chosen = configInfo.chosen;
-                mergedInfo.chosennum = qMin(configInfo.chosennum, scannedBank.size); // 确保不超过实际题目数
-                break;
+        if (!ref.bank.isEmpty()) {
+            const QString key = Question::typeToString(ref.type) + "/" + ref.bank;
+            auto bankIt = banks.find(key);
+            if (bankIt == banks.end()) {
+                QuestionBankInfo info;
+                info.src = ref.bank;
+                info.type = ref.type;
+                QHash<int, Question> byIndex;
+                for (const Question &question : QuestionBank().loadAllQuestionsFromBank(subjectPath, info)) {
+                    byIndex.insert(question.getSourceIndex(), question);
+                }
+                bankIt = banks.insert(key, byIndex);
+            }
+            
+            auto questionIt = bankIt->constFind(ref.index);
+            if (questionIt != bankIt->constEnd() && questionRefHash(*questionIt) == ref.hash) {
+                questions.append(*questionIt);
+                continue;
             }
         }
-        mergedFillBlankBanks.append(mergedInfo);
+        
+        // 题目不来自题库时使用存档时备份的内容；题库已被修改的题目没有备份，存档无法恢复
+        if (!backupLoaded) {
+            backupLoaded = true;
+            const QJsonObject content = JsonUtils::loadJsonFromFile(checkpointContentPath());
+            if (content["session_id"].toString() == m_checkpoint.sessionId) {
+                const QJsonObject dataObj = content["data"].toObject();
+                for (auto it = dataObj.constBegin(); it != dataObj.constEnd(); ++it) {
+                    backup.insert(it.key().toInt(), Question(it.value().toObject()));
+                }
+            }
+        }
+        auto backupIt = backup.constFind(i);
+        if (backupIt == backup.constEnd()) {
+            qWarning() << "Checkpoint question" << i << "is missing from bank" << ref.bank << "and has no backup";
+            return QList<Question>();
+        }
+        questions.append(*backupIt);
     }
-    mergedBank.setFillBlankBanks(mergedFillBlankBanks);
     
+    return questions;
+}
+
+QuestionBank ConfigManager::mergeQuestionBankInfo(const QuestionBank &configBank, const QuestionBank &scannedBank, const QString &subjectName) const
+{
+    static const QuestionType kBankTypes[] = {
+        QuestionType::Choice,
+        QuestionType::TrueOrFalse,
+        QuestionType::FillBlank
+    };
+    
+    QuestionBank mergedBank(subjectName);
+    for (QuestionType type : kBankTypes) {
+        mergedBank.setBanks(type, mergeBankList(configBank.getBanks(type), scannedBank.getBanks(type)));
+    }
     return mergedBank;
 }
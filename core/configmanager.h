@@ -5,8 +5,19 @@
 #include <QStringList>
 #include <QJsonObject>
 #include <QMap>
+#include <QTimer>
 #include "../models/questionbank.h"
 
+// 存档中题目的引用：恢复时从题库重新加载，不来自题库的题目使用题目内容文件中的备份
+struct CheckpointQuestionRef {
+    QString bank;           // 题库src，为空表示题目不是从题库加载的（如错题复习）
+    QuestionType type;
+    int index;              // 题目在题库文件data数组中的位置
+    QByteArray hash;        // 题目内容哈希（截短）
+    
+    CheckpointQuestionRef() : type(QuestionType::Choice), index(-1) {}
+};
+
 struct CheckpointData {
     int trueOrFalseCheck;
     int choiceCheck;
@@ -27,36 +38,62 @@ struct CheckpointData {
     int correctCount;                   // 答对题目数
     int wrongCount;                     // 答错题目数
     
+    QString sessionId;                  // 会话标识，与作答日志（SessionJournal）对应
+    
+    // 新格式存档只保存题目引用，上面的题目列表只在内存中使用（保存时生成引用）或来自旧格式存档
+    QVector<CheckpointQuestionRef> questionRefs;
+    
     CheckpointData() : trueOrFalseCheck(0), choiceCheck(0), fillBlankCheck(0), 
                       correctCount(0), wrongCount(0) {}
 };
 
+/**
+ * @brief 程序配置，分为三个独立保存的部分
+ *
+ * - config.json：设置（当前科目、乱序、助手参数），启动时读取
+ * - banks.json：各科目的题库选择，第一次用到时才读取并扫描题库目录
+ * - checkpoint.json：上次练习的存档，第一次用到时才读取
+ *
+ * 修改只标记对应部分，saveConfig()只写入有改动的文件；
+ * 频繁的修改（如拖动滑块）用scheduleSave()合并为一次保存。
+ */
 class ConfigManager
 {
 public:
     ConfigManager();
+    ~ConfigManager();
     
     // Configuration file management
+    // 读取设置；旧版本config.json中的题库选择和存档会迁移到各自的文件
     bool loadConfig(const QString &configPath = "config.json");
-    bool saveConfig(const QString &configPath = "config.json");
+    // 立即写入所有有改动的部分
+    bool saveConfig();
+    // 延迟保存，短时间内的多次修改只写入一次
+    void scheduleSave();
+    bool hasPendingChanges() const { return m_dirtyStores != 0; }
 
     bool isShuffleQuestionsEnabled() const { return m_shuffleQuestionsEnabled; }
-    void setShuffleQuestionsEnabled(bool enabled) { m_shuffleQuestionsEnabled = enabled; }
+    void setShuffleQuestionsEnabled(bool enabled) { m_shuffleQuestionsEnabled = enabled; m_dirtyStores |= SettingsStore; }
 
     int getAssistantSearchTopK() const { return m_assistantSearchTopK; }
-    void setAssistantSearchTopK(int k) { m_assistantSearchTopK = qBound(1, k, 50); }
+    void setAssistantSearchTopK(int k) { m_assistantSearchTopK = qBound(1, k, 50); m_dirtyStores |= SettingsStore; }
 
     double getAssistantAutoThreshold() const { return m_assistantAutoThreshold; }
-    void setAssistantAutoThreshold(double v) { m_assistantAutoThreshold = qBound(0.0, v, 1.0); }
+    void setAssistantAutoThreshold(double v) { m_assistantAutoThreshold = qBound(0.0, v, 1.0); m_dirtyStores |= SettingsStore; }
+
+    // 渲染器对象池中保留的空闲渲染器数量，启动时生效
+    int getRendererPoolSize() const { return m_rendererPoolSize; }
+    void setRendererPoolSize(int size) { m_rendererPoolSize = qBound(0, size, 32); m_dirtyStores |= SettingsStore; }
     
     // Subject management
     QString getCurrentSubject() const { return m_currentSubject; }
-    void setCurrentSubject(const QString &subject) { m_currentSubject = subject; }
+    void setCurrentSubject(const QString &subject);
     QStringList getAvailableSubjects() const;
     QStringList getSubjects() const { return getAvailableSubjects(); }
     void addSubject(const QString &subject, const QString &path);
     void removeSubject(const QString &subject);
     void refreshSubjectBanks(const QString &subject);
+    void applyScannedBank(const QString &subject, const QuestionBank &scannedBank);
     
     // Question bank management
     QuestionBank getQuestionBank(const QString &subject) const;
@@ -65,9 +102,11 @@ public:
     
     // Checkpoint management
     bool hasCheckpoint() const;
-    CheckpointData getCheckpoint() const { return m_checkpoint; }
-    void setCheckpoint(const CheckpointData &checkpoint) { m_checkpoint = checkpoint; }
+    CheckpointData getCheckpoint() const;
+    void setCheckpoint(const CheckpointData &checkpoint);
     void clearCheckpoint();
+    // 存档中的题目：旧格式直接返回存档内容，新格式按引用从题库加载
+    QList<Question> loadCheckpointQuestions(const QString &subjectPath) const;
     
     // Paths
     QString getSubjectPath(const QString &subject) const;
@@ -87,20 +126,48 @@ public:
     void createDefaultConfigFile();
     
 private:
+    enum Store {
+        SettingsStore = 0x1,
+        BanksStore = 0x2,
+        CheckpointStore = 0x4
+    };
+    
     QString m_currentSubject;
     QMap<QString, QuestionBank> m_questionBanks;
     QMap<QString, QString> m_subjectPaths; // 存储科目名称到科目路径的映射
     CheckpointData m_checkpoint;
+    QString m_configPath = "config.json";
+    QString m_checkpointContentSession;  // 已写入题目内容文件的会话标识
     QString m_lastError;
     bool m_shuffleQuestionsEnabled = true;
+    
+    bool m_banksLoaded = false;
+    bool m_checkpointLoaded = false;
+    int m_dirtyStores = 0;
+    bool m_legacyConfigPending = false;    // config.json仍包含尚未迁移完成的题库选择和存档
+    QTimer m_saveTimer;
 
     int m_assistantSearchTopK = 5;
     double m_assistantAutoThreshold = 0.85;
+    int m_rendererPoolSize = 6;
     
+    QString storePath(const QString &fileName) const;
+    void parseSettings(const QJsonObject &json);
+    QJsonObject settingsToJson() const;
+    void importStores(const QJsonObject &config);
+    void ensureBanksLoaded() const;
+    void ensureCheckpointLoaded() const;
+    void loadBanksStore();
+    void loadCheckpointStore();
+    bool saveCheckpointStore();
     void parseQuestionBanks(const QJsonObject &json);
     QJsonObject questionBanksToJson() const;
     void parseCheckpoint(const QJsonObject &json);
     QJsonObject checkpointToJson() const;
+    QList<Question> checkpointQuestions() const;
+    void prepareCheckpointForSave();
+    QString checkpointContentPath() const;
+    void mergeScannedBanks(const QMap<QString, QuestionBank> &scannedBanks);
     QuestionBank mergeQuestionBankInfo(const QuestionBank &configBank, const QuestionBank &scannedBank, const QString &subjectName) const;
 };
 
@@ -10,10 +10,18 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QJsonDocument>
+#include <QUuid>
+#include <utility>
 
 PracticeManager::PracticeManager(QObject *parent)
     : QObject(parent)
     , m_wrongAnswerSet(nullptr)
+    , m_journal(new SessionJournal(this))
+    , m_journalConfig(nullptr)
+    , m_snapshotWritten(false)
+    , m_loadWatcher(new QFutureWatcher<QList<Question>>(this))
+    , m_loadingConfig(nullptr)
+    , m_loadingShuffle(true)
 {
     // Connect question manager signals
     connect(&m_questionManager, &QuestionManager::questionAnswered,
@@ -24,6 +32,13 @@ PracticeManager::PracticeManager(QObject *parent)
             this, [this](int index) {
                 emit questionChanged(index, getTotalQuestions());
             });
+    
+    connect(m_loadWatcher, &QFutureWatcher<QList<Question>>::progressValueChanged,
+            this, [this](int value) {
+                emit questionLoadingProgress(value, m_loadWatcher->progressMaximum());
+            });
+    connect(m_loadWatcher, &QFutureWatcher<QList<Question>>::finished,
+            this, &PracticeManager::onQuestionsLoaded);
 }
 
 bool PracticeManager::startNewPractice(const QString &subject, ConfigManager *configManager)
@@ -45,6 +60,74 @@ bool PracticeManager::startNewPractice(const QString &subject, ConfigManager *co
         return false;
     }
     
+    beginNewSession(subject, configManager);
+    return true;
+}
+
+bool PracticeManager::startNewPracticeAsync(const QString &subject, ConfigManager *configManager)
+{
+    if (!configManager || isLoadingQuestions()) {
+        return false;
+    }
+    
+    QuestionBank bank = configManager->getQuestionBank(subject);
+    if (!bank.hasSelectedBanks()) {
+        qWarning() << "No question banks selected for subject:" << subject;
+        return false;
+    }
+    
+    m_currentSubjectPath = configManager->getSubjectPath(subject);
+    m_loadingConfig = configManager;
+    m_loadingSubject = subject;
+    m_loadingShuffle = configManager->isShuffleQuestionsEnabled();
+    m_loadWatcher->setFuture(bank.loadSelectedQuestionsAsync(m_currentSubjectPath, m_loadingShuffle));
+    return true;
+}
+
+void PracticeManager::cancelQuestionLoading()
+{
+    if (isLoadingQuestions()) {
+        // 已开始的题库会读完，之后的题库不再加载，finished信号照常发出
+        m_loadWatcher->cancel();
+    }
+}
+
+void PracticeManager::onQuestionsLoaded()
+{
+    ConfigManager *configManager = m_loadingConfig;
+    if (!configManager) {
+        return;
+    }
+    m_loadingConfig = nullptr;
+    const QString subject = m_loadingSubject;
+    
+    if (m_loadWatcher->isCanceled()) {
+        qDebug() << "Question loading canceled for subject:" << subject;
+        emit questionLoadingFinished(subject, false, true);
+        return;
+    }
+    
+    QList<Question> questions = m_loadWatcher->result();
+    // 释放结果占用的内存；m_loadingConfig已清空，空future触发的finished会被忽略
+    m_loadWatcher->setFuture(QFuture<QList<Question>>());
+    
+    if (questions.isEmpty()) {
+        qWarning() << "Failed to load questions for subject:" << subject;
+        emit questionLoadingFinished(subject, false, false);
+        return;
+    }
+    
+    if (m_loadingShuffle) {
+        QuestionBank::shuffleQuestionOrder(questions);
+    }
+    m_questionManager.setQuestions(std::move(questions));
+    
+    beginNewSession(subject, configManager);
+    emit questionLoadingFinished(subject, true, false);
+}
+
+void PracticeManager::beginNewSession(const QString &subject, ConfigManager *configManager)
+{
     // Initialize session
     m_currentSession = PracticeSession();
     m_currentSession.mode = PracticeMode::Normal;
@@ -52,10 +135,11 @@ bool PracticeManager::startNewPractice(const QString &subject, ConfigManager *co
     m_currentSession.startTime = QDateTime::currentDateTime();
     m_currentSession.totalQuestions = m_questionManager.getQuestionCount();
     
+    // 开始时写入一次完整存档，之后的作答只追加到日志，程序意外退出也能恢复
+    writeBaseCheckpoint(configManager);
+    
     setState(PracticeState::InProgress);
     emit practiceStarted(PracticeMode::Normal);
-    
-    return true;
 }
 
 bool PracticeManager::resumePractice(ConfigManager *configManager)
@@ -72,20 +156,36 @@ bool PracticeManager::resumePractice(ConfigManager *configManager)
     // 设置当前科目路径
     m_currentSubjectPath = configManager->getSubjectPath(m_currentSession.subject);
     
-    // Reconstruct questions from checkpoint
+    // 同一会话的二进制快照比JSON存档新，直接使用，不再加载题库
     QList<Question> allQuestions;
-    allQuestions.append(checkpoint.trueOrFalseData);
-    allQuestions.append(checkpoint.choiceData);
-    allQuestions.append(checkpoint.fillBlankData);
+    qint64 elapsedSeconds = 0;
+    SessionSnapshot snapshot;
+    if (!checkpoint.sessionId.isEmpty() && snapshot.load() && snapshot.sessionId == checkpoint.sessionId) {
+        allQuestions = std::move(snapshot.questions);
+        checkpoint.trueOrFalseCheck = 0;
+        checkpoint.choiceCheck = snapshot.currentIndex;
+        checkpoint.fillBlankCheck = 0;
+        checkpoint.answeredFlags = snapshot.answeredFlags;
+        checkpoint.userAnswers = snapshot.userAnswers;
+        checkpoint.userMultiAnswers = snapshot.userMultiAnswers;
+        checkpoint.correctFlags = snapshot.correctFlags;
+        checkpoint.correctCount = snapshot.correctCount;
+        checkpoint.wrongCount = snapshot.wrongCount;
+        elapsedSeconds = snapshot.elapsedSeconds;
+        qDebug() << "Resuming practice from session snapshot";
+    } else {
+        // Reconstruct questions from checkpoint（新格式存档按引用从题库加载）
+        allQuestions = configManager->loadCheckpointQuestions(m_currentSubjectPath);
+    }
     
     if (allQuestions.isEmpty()) {
         return false;
     }
     
-    m_questionManager.setQuestions(allQuestions);
-    
     // 恢复答题状态数据
-    int questionCount = allQuestions.size();
+    const int questionCount = allQuestions.size();
+    m_questionManager.setQuestions(std::move(allQuestions));
+    
     if (checkpoint.answeredFlags.size() == questionCount) {
         // 先清空错题列表，避免重复添加
         m_questionManager.clearWrongAnswers();
@@ -103,6 +203,9 @@ bool PracticeManager::resumePractice(ConfigManager *configManager)
                     m_questionManager.setUserAnswersWithoutCheck(i, checkpoint.userMultiAnswers[i]);
                 }
                 
+                // 恢复存档中记录的判题结果，避免恢复后重新判题
+                m_questionManager.setAnswerCorrect(i, checkpoint.correctFlags[i]);
+                
                 // 如果答错了，添加到错题列表
                 if (!checkpoint.correctFlags[i]) {
                     m_questionManager.addWrongAnswer(i);
@@ -115,19 +218,44 @@ bool PracticeManager::resumePractice(ConfigManager *configManager)
         m_questionManager.setWrongCount(checkpoint.wrongCount);
     }
     
+    // 重放存档之后记录的作答
+    int lastJournaledIndex = -1;
+    if (!checkpoint.sessionId.isEmpty()) {
+        const QList<SessionJournal::Record> records = m_journal->resume(checkpoint.sessionId);
+        for (const SessionJournal::Record &record : records) {
+            applyJournalRecord(record);
+            lastJournaledIndex = record.index;
+        }
+        if (!records.isEmpty()) {
+            qDebug() << "Replayed" << records.size() << "journaled answers";
+        }
+        m_journalConfig = configManager;
+    }
+    
     // Initialize session
     m_currentSession = PracticeSession();
     m_currentSession.mode = PracticeMode::Resume;
     m_currentSession.subject = configManager->getCurrentSubject();
-    m_currentSession.startTime = QDateTime::currentDateTime();
-    m_currentSession.totalQuestions = allQuestions.size();
+    // 快照中记录了已用时间，计时从上次停下的地方继续
+    m_currentSession.startTime = QDateTime::currentDateTime().addSecs(-elapsedSeconds);
+    m_snapshotWritten = false;
+    m_currentSession.totalQuestions = questionCount;
     
     // Set current position based on checkpoint
     int currentPos = checkpoint.trueOrFalseCheck + checkpoint.choiceCheck + checkpoint.fillBlankCheck;
-    if (currentPos < allQuestions.size()) {
+    if (lastJournaledIndex >= 0) {
+        // 日志中最后作答的题目比存档中的位置更新
+        currentPos = lastJournaledIndex;
+    }
+    if (currentPos < questionCount) {
         m_questionManager.setCurrentIndex(currentPos);
     }
     
+    // 旧版本的存档没有会话标识，补写一次后开始记录日志
+    if (checkpoint.sessionId.isEmpty()) {
+        writeBaseCheckpoint(configManager);
+    }
+    
     setState(PracticeState::InProgress);
     emit practiceStarted(PracticeMode::Resume);
     
@@ -147,6 +275,10 @@ bool PracticeManager::startReviewPractice(const QList<Question> &wrongQuestions,
     
     m_questionManager.setQuestions(wrongQuestions);
     
+    // 错题复习不自动存档，不记录日志
+    m_journal->close();
+    m_journalConfig = nullptr;
+    
     // Initialize session
     m_currentSession = PracticeSession();
     m_currentSession.mode = PracticeMode::Review;
@@ -165,6 +297,11 @@ void PracticeManager::pausePractice()
     if (m_currentSession.state == PracticeState::InProgress) {
         m_currentSession.pauseTime = QDateTime::currentDateTime();
         setState(PracticeState::Paused);
+        
+        // 暂停时写入快照，之后从存档继续时直接读取
+        if (m_journalConfig) {
+            writeSnapshot();
+        }
         emit practicePaused();
     }
 }
@@ -198,8 +335,17 @@ void PracticeManager::completePractice()
         updateSessionStatistics();
         setState(PracticeState::Completed);
         
+        // 练习已完成，自动写入的存档和日志不再需要
+        if (m_journalConfig) {
+            m_journalConfig->clearCheckpoint();
+            m_journalConfig->saveConfig();
+            m_journal->remove();
+            removeSnapshot();
+            m_journalConfig = nullptr;
+        }
+        
         // Save wrong answers if any
-        QList<Question> wrongQuestions = m_questionManager.getWrongAnswers();
+        const QList<Question> &wrongQuestions = m_questionManager.getWrongAnswers();
         qDebug() << "[DEBUG] completePractice: Found" << wrongQuestions.size() << "wrong answers";
         
         if (!wrongQuestions.isEmpty()) {
@@ -227,17 +373,51 @@ void PracticeManager::saveCheckpoint(ConfigManager *configManager)
         return;
     }
     
+    // 完整存档已包含日志中的全部作答，沿用会话标识并清空日志
+    writeBaseCheckpoint(configManager, m_journal->sessionId());
+    writeSnapshot();
+    m_journal->close();
+    m_journalConfig = nullptr;
+    
+    setState(PracticeState::Saved);
+}
+
+void PracticeManager::abandonPractice()
+{
+    if (!m_journalConfig) {
+        return;
+    }
+    
+    if (m_currentSession.mode == PracticeMode::Normal) {
+        // 本次练习开始时才写入的存档，不保存退出时一并删除
+        m_journalConfig->clearCheckpoint();
+        m_journalConfig->saveConfig();
+        m_journal->remove();
+        removeSnapshot();
+    } else {
+        // 从存档继续的练习恢复到继续之前的状态；本次写过的快照包含要撤销的作答
+        m_journal->rollback();
+        m_journal->close();
+        if (m_snapshotWritten) {
+            removeSnapshot();
+        }
+    }
+    m_journalConfig = nullptr;
+}
+
+CheckpointData PracticeManager::buildCheckpoint() const
+{
     // Create checkpoint data
     CheckpointData checkpoint;
     
     // For simplicity, we'll save all questions as choice type
     // In a real implementation, you'd separate by type
-    QList<Question> allQuestions = m_questionManager.getAllQuestions();
+    // 以常量引用读取，赋值时仅共享隐式数据，不再逐题深拷贝
+    const QList<Question> &allQuestions = m_questionManager.getAllQuestions();
     int currentIndex = m_questionManager.getCurrentIndex();
     
     checkpoint.choiceData = allQuestions;
     checkpoint.choiceCheck = currentIndex;
-    checkpoint.wrongAnswers = m_questionManager.getWrongAnswers();
     
     // 保存答题状态数据
     int questionCount = allQuestions.size();
@@ -250,16 +430,105 @@ void PracticeManager::saveCheckpoint(ConfigManager *configManager)
         checkpoint.answeredFlags[i] = m_questionManager.isAnswered(i);
         checkpoint.userAnswers[i] = m_questionManager.getUserAnswer(i);
         checkpoint.userMultiAnswers[i] = m_questionManager.getUserAnswers(i);
-        checkpoint.correctFlags[i] = m_questionManager.checkAnswer(i);
+        checkpoint.correctFlags[i] = m_questionManager.isAnswerCorrect(i);
     }
     
     checkpoint.correctCount = m_questionManager.getCorrectCount();
     checkpoint.wrongCount = m_questionManager.getWrongCount();
     
+    return checkpoint;
+}
+
+void PracticeManager::writeBaseCheckpoint(ConfigManager *configManager, const QString &sessionId)
+{
+    CheckpointData checkpoint = buildCheckpoint();
+    if (sessionId.isEmpty()) {
+        // 新会话，旧会话的快照不再需要
+        checkpoint.sessionId = QUuid::createUuid().toString(QUuid::WithoutBraces);
+        removeSnapshot();
+    } else {
+        checkpoint.sessionId = sessionId;
+    }
+    
     configManager->setCheckpoint(checkpoint);
-    configManager->saveConfig();
+    if (sessionId.isEmpty()) {
+        // 新会话的存档延迟写入，不阻塞显示第一道题；写入前崩溃时
+        // 日志的会话标识与磁盘上的旧存档不匹配，重放时被忽略
+        configManager->scheduleSave();
+    } else {
+        // 沿用会话标识时先写存档再清空日志：两步之间崩溃时，
+        // 日志中的作答已包含在存档中，重放时跳过已作答的题目
+        configManager->saveConfig();
+    }
     
-    setState(PracticeState::Saved);
+    m_journal->start(checkpoint.sessionId);
+    m_journalConfig = configManager;
+}
+
+void PracticeManager::applyJournalRecord(const SessionJournal::Record &record)
+{
+    const int index = record.index;
+    if (index < 0 || index >= m_questionManager.getQuestionCount() || m_questionManager.isAnswered(index)) {
+        return;
+    }
+    
+    // 与恢复存档相同：不重新判题，直接使用记录的结果
+    if (!record.answer.isEmpty()) {
+        m_questionManager.setUserAnswerWithoutCheck(index, record.answer);
+    }
+    if (!record.answers.isEmpty()) {
+        m_questionManager.setUserAnswersWithoutCheck(index, record.answers);
+    }
+    m_questionManager.setAnswered(index, true);
+    m_questionManager.setAnswerCorrect(index, record.correct);
+    
+    if (record.correct) {
+        m_questionManager.setCorrectCount(m_questionManager.getCorrectCount() + 1);
+    } else {
+        m_questionManager.setWrongCount(m_questionManager.getWrongCount() + 1);
+        m_questionManager.addWrongAnswer(index);
+    }
+}
+
+void PracticeManager::writeSnapshot()
+{
+    const QString sessionId = m_journal->sessionId();
+    if (sessionId.isEmpty()) {
+        return;
+    }
+    
+    SessionSnapshot snapshot;
+    snapshot.sessionId = sessionId;
+    snapshot.currentIndex = m_questionManager.getCurrentIndex();
+    snapshot.elapsedSeconds = getElapsedTime();
+    snapshot.questions = m_questionManager.getAllQuestions();
+    
+    const int questionCount = snapshot.questions.size();
+    snapshot.answeredFlags.resize(questionCount);
+    snapshot.userAnswers.resize(questionCount);
+    snapshot.userMultiAnswers.resize(questionCount);
+    snapshot.correctFlags.resize(questionCount);
+    for (int i = 0; i < questionCount; ++i) {
+        snapshot.answeredFlags[i] = m_questionManager.isAnswered(i);
+        snapshot.userAnswers[i] = m_questionManager.getUserAnswer(i);
+        snapshot.userMultiAnswers[i] = m_questionManager.getUserAnswers(i);
+        snapshot.correctFlags[i] = m_questionManager.isAnswerCorrect(i);
+    }
+    snapshot.correctCount = m_questionManager.getCorrectCount();
+    snapshot.wrongCount = m_questionManager.getWrongCount();
+    
+    if (snapshot.save()) {
+        m_snapshotWritten = true;
+    } else {
+        // 写入失败时旧快照可能比存档更旧，删除后恢复时使用存档
+        removeSnapshot();
+    }
+}
+
+void PracticeManager::removeSnapshot()
+{
+    SessionSnapshot::remove();
+    m_snapshotWritten = false;
 }
 
 int PracticeManager::getTotalQuestions() const
@@ -421,7 +690,7 @@ QVector<int> PracticeManager::getUnansweredQuestions() const
 
 void PracticeManager::saveWrongAnswers(const QString &filePath)
 {
-    QList<Question> wrongQuestions = m_questionManager.getWrongAnswers();
+    const QList<Question> &wrongQuestions = m_questionManager.getWrongAnswers();
     if (wrongQuestions.isEmpty()) {
         return;
     }
@@ -494,6 +763,9 @@ QStringList PracticeManager::getAvailableWrongAnswerFiles(const QString &directo
 
 void PracticeManager::reset()
 {
+    cancelQuestionLoading();
+    m_journal->close();
+    m_journalConfig = nullptr;
     m_questionManager.reset();
     m_currentSession = PracticeSession();
 }
@@ -501,6 +773,17 @@ void PracticeManager::reset()
 void PracticeManager::onQuestionAnswered(int index, bool correct)
 {
     qDebug() << "PracticeManager::onQuestionAnswered called: index=" << index << ", correct=" << correct;
+    
+    if (m_journal->isActive()) {
+        SessionJournal::Record record;
+        record.index = index;
+        record.answer = m_questionManager.getUserAnswer(index);
+        record.answers = m_questionManager.getUserAnswers(index);
+        record.correct = correct;
+        record.timestamp = QDateTime::currentMSecsSinceEpoch();
+        m_journal->append(record);
+    }
+    
     updateSessionStatistics();
     qDebug() << "Emitting answerSubmitted signal";
     emit answerSubmitted(index, correct);
@@ -544,7 +827,7 @@ void PracticeManager::setWrongAnswerSet(WrongAnswerSet *wrongAnswerSet)
 
 bool PracticeManager::askUserToImportWrongAnswers()
 {
-    QList<Question> wrongQuestions = m_questionManager.getWrongAnswers();
+    const QList<Question> &wrongQuestions = m_questionManager.getWrongAnswers();
     qDebug() << "[DEBUG] askUserToImportWrongAnswers: Wrong questions count:" << wrongQuestions.size();
     
     if (wrongQuestions.isEmpty()) {
@@ -570,8 +853,8 @@ int PracticeManager::importWrongAnswersToSet()
         return -1;
     }
     
-    QList<Question> wrongQuestions = m_questionManager.getWrongAnswers();
-    QVector<int> wrongIndices = m_questionManager.getWrongAnswerIndices();
+    const QList<Question> &wrongQuestions = m_questionManager.getWrongAnswers();
+    const QVector<int> &wrongIndices = m_questionManager.getWrongAnswerIndices();
     
     qDebug() << "[DEBUG] importWrongAnswersToSet: Wrong questions count:" << wrongQuestions.size();
     qDebug() << "[DEBUG] importWrongAnswersToSet: Wrong indices count:" << wrongIndices.size();
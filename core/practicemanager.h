@@ -4,9 +4,12 @@
 #include <QObject>
 #include <QTimer>
 #include <QDateTime>
+#include <QFutureWatcher>
 #include "questionmanager.h"
 #include "configmanager.h"
 #include "wronganswerset.h"
+#include "sessionjournal.h"
+#include "sessionsnapshot.h"
 
 enum class PracticeMode {
     Normal,         // 正常练习模式
@@ -57,12 +60,18 @@ public:
     
     // Practice session management
     bool startNewPractice(const QString &subject, ConfigManager *configManager);
+    // 在后台线程加载题目，完成后开始练习并发出questionLoadingFinished；
+    // 没有已选题库或正在加载时直接返回false
+    bool startNewPracticeAsync(const QString &subject, ConfigManager *configManager);
+    void cancelQuestionLoading();
+    bool isLoadingQuestions() const { return m_loadingConfig != nullptr; }
     bool resumePractice(ConfigManager *configManager);
     bool startReviewPractice(const QList<Question> &wrongQuestions, const QString &subjectPath = QString());
     void pausePractice();
     void resumePractice();  // 从暂停状态恢复
     void completePractice();
     void savePractice(ConfigManager *configManager);
+    void abandonPractice();  // 不保存退出：撤销本次练习写入的存档和作答日志
     
     // Question management
     QuestionManager* getQuestionManager() { return &m_questionManager; }
@@ -133,8 +142,11 @@ signals:
     void progressChanged(double percentage);
     void statisticsUpdated(int correct, int wrong, double accuracy);
     void wrongAnswersImportRequested(const QList<Question> &wrongQuestions, const QString &subject);
+    void questionLoadingProgress(int loadedBanks, int totalBanks);
+    void questionLoadingFinished(const QString &subject, bool success, bool canceled);
     
 private slots:
+    void onQuestionsLoaded();
     void onQuestionAnswered(int index, bool correct);
     void onAllQuestionsAnswered();
     
@@ -144,6 +156,23 @@ private:
     WrongAnswerSet *m_wrongAnswerSet;
     QString m_currentSubjectPath;  // 添加当前科目路径存储
     
+    // 作答日志：存档之后的每次作答追加到日志，恢复时重放
+    SessionJournal *m_journal;
+    ConfigManager *m_journalConfig;  // 日志对应的存档所在的配置，为空表示本次练习不记录日志
+    bool m_snapshotWritten;          // 本次练习是否写过快照
+    
+    // 异步加载题目
+    QFutureWatcher<QList<Question>> *m_loadWatcher;
+    ConfigManager *m_loadingConfig;  // 正在为其加载题目的配置，为空表示没有进行中的加载
+    QString m_loadingSubject;
+    bool m_loadingShuffle;
+    
+    void beginNewSession(const QString &subject, ConfigManager *configManager);
+    CheckpointData buildCheckpoint() const;
+    void writeBaseCheckpoint(ConfigManager *configManager, const QString &sessionId = QString());
+    void applyJournalRecord(const SessionJournal::Record &record);
+    void writeSnapshot();
+    void removeSnapshot();
     void updateSessionStatistics();
     void setState(PracticeState state);
     QString generateWrongAnswersFileName() const;
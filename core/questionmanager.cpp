@@ -1,6 +1,7 @@
 #include "questionmanager.h"
 #include <QDebug>
 #include <QDir>
+#include <utility>
 
 QuestionManager::QuestionManager(QObject *parent)
     : QObject(parent)
@@ -12,15 +13,10 @@ QuestionManager::QuestionManager(QObject *parent)
 
 bool QuestionManager::loadQuestions(const QuestionBank &bank, const QString &subjectPath, bool shuffleQuestions)
 {
+    // 返回值直接移动进来，避免整份题目列表再复制一次
     m_questions = bank.loadSelectedQuestions(subjectPath, shuffleQuestions);
-    initializeAnswerTracking();
-    
-    if (!m_questions.isEmpty()) {
-        setCurrentIndex(0);
-        return true;
-    }
-    
-    return false;
+    onQuestionsReplaced();
+    return !m_questions.isEmpty();
 }
 
 bool QuestionManager::loadQuestionsFromFiles(const QStringList &filePaths)
@@ -40,19 +36,23 @@ bool QuestionManager::loadQuestionsFromFiles(const QStringList &filePaths)
 void QuestionManager::setQuestions(const QList<Question> &questions)
 {
     m_questions = questions;
-    initializeAnswerTracking();
-    
-    if (!m_questions.isEmpty()) {
-        setCurrentIndex(0);
-    }
+    onQuestionsReplaced();
+}
+
+void QuestionManager::setQuestions(QList<Question> &&questions)
+{
+    m_questions = std::move(questions);
+    onQuestionsReplaced();
 }
 
-Question QuestionManager::getQuestion(int index) const
+const Question &QuestionManager::getQuestion(int index) const
 {
     if (isValidIndex(index)) {
-        return m_questions[index];
+        return m_questions.at(index);
     }
-    return Question();
+    // 越界时返回共享的空题目，调用方无需为返回值分配新对象
+    static const Question emptyQuestion;
+    return emptyQuestion;
 }
 
 void QuestionManager::setCurrentIndex(int index)
@@ -63,7 +63,7 @@ void QuestionManager::setCurrentIndex(int index)
     }
 }
 
-Question QuestionManager::getCurrentQuestion() const
+const Question &QuestionManager::getCurrentQuestion() const
 {
     return getQuestion(m_currentIndex);
 }
@@ -108,24 +108,19 @@ void QuestionManager::moveToLast()
 
 bool QuestionManager::isAnswered(int index) const
 {
-    if (isValidIndex(index)) {
-        return m_answeredFlags[index];
-    }
-    return false;
+    return m_answers.isAnswered(index);
 }
 
 void QuestionManager::setAnswered(int index, bool answered)
 {
-    if (isValidIndex(index)) {
-        m_answeredFlags[index] = answered;
-    }
+    m_answers.setAnswered(index, answered);
 }
 
 QVector<int> QuestionManager::getUnansweredQuestions() const
 {
     QVector<int> unanswered;
     for (int i = 0; i < m_questions.size(); ++i) {
-        if (!m_answeredFlags[i]) {
+        if (!m_answers.isAnswered(i)) {
             unanswered.append(i + 1); // 1-based indexing for display
         }
     }
@@ -136,37 +131,24 @@ QVector<int> QuestionManager::getAnsweredQuestions() const
 {
     QVector<int> answered;
     for (int i = 0; i < m_questions.size(); ++i) {
-        if (m_answeredFlags[i]) {
+        if (m_answers.isAnswered(i)) {
             answered.append(i + 1); // 1-based indexing for display
         }
     }
     return answered;
 }
 
-int QuestionManager::getAnsweredCount() const
-{
-    int count = 0;
-    for (bool answered : m_answeredFlags) {
-        if (answered) count++;
-    }
-    return count;
-}
-
-int QuestionManager::getUnansweredCount() const
-{
-    return m_questions.size() - getAnsweredCount();
-}
-
 void QuestionManager::setUserAnswer(int index, const QString &answer)
 {
     qDebug() << "QuestionManager::setUserAnswer called: index=" << index << ", answer=" << answer;
     
     if (isValidIndex(index)) {
-        m_userAnswers[index] = answer;
+        m_answers.setAnswer(index, answer);
         setAnswered(index, true);
         
         // Check if answer is correct
         bool correct = m_questions[index].checkAnswer(answer);
+        m_answers.setCorrect(index, correct);
         qDebug() << "Answer check result: correct=" << correct;
         
         if (correct) {
@@ -191,29 +173,30 @@ void QuestionManager::setUserAnswer(int index, const QString &answer)
 void QuestionManager::setUserAnswerWithoutCheck(int index, const QString &answer)
 {
     if (isValidIndex(index)) {
-        m_userAnswers[index] = answer;
+        m_answers.setAnswer(index, answer);
         setAnswered(index, true);
-        // 不进行答案检查，不更新统计数据，不添加错题
+        // 不进行答案检查，不更新统计数据，不添加错题；判题结果由调用方通过setAnswerCorrect恢复
     }
 }
 
 void QuestionManager::setUserAnswersWithoutCheck(int index, const QStringList &answers)
 {
     if (isValidIndex(index)) {
-        m_userMultiAnswers[index] = answers;
+        m_answers.setMultiAnswers(index, answers);
         setAnswered(index, true);
-        // 不进行答案检查，不更新统计数据，不添加错题
+        // 不进行答案检查，不更新统计数据，不添加错题；判题结果由调用方通过setAnswerCorrect恢复
     }
 }
 
 void QuestionManager::setUserAnswers(int index, const QStringList &answers)
 {
     if (isValidIndex(index)) {
-        m_userMultiAnswers[index] = answers;
+        m_answers.setMultiAnswers(index, answers);
         setAnswered(index, true);
         
         // Check if answers are correct
         bool correct = m_questions[index].checkAnswers(answers);
+        m_answers.setCorrect(index, correct);
         if (correct) {
             m_correctCount++;
         } else {
@@ -232,41 +215,32 @@ void QuestionManager::setUserAnswers(int index, const QStringList &answers)
 
 QString QuestionManager::getUserAnswer(int index) const
 {
-    if (isValidIndex(index)) {
-        return m_userAnswers[index];
-    }
-    return QString();
+    return m_answers.answer(index);
 }
 
 QStringList QuestionManager::getUserAnswers(int index) const
 {
-    if (isValidIndex(index)) {
-        return m_userMultiAnswers[index];
-    }
-    return QStringList();
+    return m_answers.multiAnswers(index);
 }
 
 QStringList QuestionManager::getUserMultiAnswers(int index) const
 {
-    if (isValidIndex(index)) {
-        return m_userMultiAnswers[index];
-    }
-    return QStringList();
+    return m_answers.multiAnswers(index);
 }
 
 bool QuestionManager::checkAnswer(int index) const
 {
-    if (!isValidIndex(index) || !isAnswered(index)) {
-        return false;
-    }
-    
-    const Question &question = m_questions[index];
-    
-    if (question.getType() == QuestionType::FillBlank) {
-        return question.checkAnswers(m_userMultiAnswers[index]);
-    } else {
-        return question.checkAnswer(m_userAnswers[index]);
-    }
+    return isAnswerCorrect(index);
+}
+
+bool QuestionManager::isAnswerCorrect(int index) const
+{
+    return m_answers.isAnswered(index) && m_answers.isCorrect(index);
+}
+
+void QuestionManager::setAnswerCorrect(int index, bool correct)
+{
+    m_answers.setCorrect(index, correct);
 }
 
 bool QuestionManager::checkCurrentAnswer() const
@@ -294,9 +268,7 @@ double QuestionManager::getAccuracy() const
 void QuestionManager::reset()
 {
     m_questions.clear();
-    m_answeredFlags.clear();
-    m_userAnswers.clear();
-    m_userMultiAnswers.clear();
+    m_answers.clear();
     m_wrongAnswers.clear();
     m_wrongAnswerIndices.clear();
     m_currentIndex = 0;
@@ -306,9 +278,7 @@ void QuestionManager::reset()
 
 void QuestionManager::resetAnswers()
 {
-    m_answeredFlags.fill(false);
-    m_userAnswers.fill(QString());
-    m_userMultiAnswers.fill(QStringList());
+    m_answers.resize(m_questions.size());
     m_wrongAnswers.clear();
     m_wrongAnswerIndices.clear();  // 修复：同时清空错题索引列表
     m_correctCount = 0;
@@ -337,13 +307,7 @@ QString QuestionManager::getQuestionTypeString(int index) const
 
 void QuestionManager::initializeAnswerTracking()
 {
-    int size = m_questions.size();
-    m_answeredFlags.resize(size);
-    m_answeredFlags.fill(false);
-    m_userAnswers.resize(size);
-    m_userAnswers.fill(QString());
-    m_userMultiAnswers.resize(size);
-    m_userMultiAnswers.fill(QStringList());
+    m_answers.resize(m_questions.size());
     m_wrongAnswers.clear();
     m_wrongAnswerIndices.clear();  // 修复：同时清空错题索引列表
     m_currentIndex = 0;
@@ -351,6 +315,15 @@ void QuestionManager::initializeAnswerTracking()
     m_wrongCount = 0;
 }
 
+void QuestionManager::onQuestionsReplaced()
+{
+    initializeAnswerTracking();
+    
+    if (!m_questions.isEmpty()) {
+        setCurrentIndex(0);
+    }
+}
+
 bool QuestionManager::isValidIndex(int index) const
 {
     return index >= 0 && index < m_questions.size();
@@ -7,6 +7,7 @@
 #include <QStringList>
 #include "../models/question.h"
 #include "../models/questionbank.h"
+#include "answerstore.h"
 
 class QuestionManager : public QObject
 {
@@ -19,16 +20,19 @@ public:
     bool loadQuestions(const QuestionBank &bank, const QString &subjectPath, bool shuffleQuestions = true);
     bool loadQuestionsFromFiles(const QStringList &filePaths);
     void setQuestions(const QList<Question> &questions);
+    void setQuestions(QList<Question> &&questions);
     
     // Question access
+    // 返回的引用在下一次 setQuestions/loadQuestions/reset 之前有效，
+    // 需要长期持有时请保存下标而不是引用
     int getQuestionCount() const { return m_questions.size(); }
-    Question getQuestion(int index) const;
-    QList<Question> getAllQuestions() const { return m_questions; }
+    const Question &getQuestion(int index) const;
+    const QList<Question> &getAllQuestions() const { return m_questions; }
     
     // Question navigation
     int getCurrentIndex() const { return m_currentIndex; }
     void setCurrentIndex(int index);
-    Question getCurrentQuestion() const;
+    const Question &getCurrentQuestion() const;
     bool hasNext() const;
     bool hasPrevious() const;
     void moveNext();
@@ -41,8 +45,8 @@ public:
     void setAnswered(int index, bool answered = true);
     QVector<int> getUnansweredQuestions() const;
     QVector<int> getAnsweredQuestions() const;
-    int getAnsweredCount() const;
-    int getUnansweredCount() const;
+    int getAnsweredCount() const { return m_answers.answeredCount(); }
+    int getUnansweredCount() const { return m_answers.unansweredCount(); }
     
     // Answer management
     void setUserAnswer(int index, const QString &answer);
@@ -54,13 +58,16 @@ public:
     QStringList getUserMultiAnswers(int index) const;
     
     // Validation
+    // 判题结果在提交时记录一次，之后的查询直接读取缓存，不再重新比对答案
     bool checkAnswer(int index) const;
     bool checkCurrentAnswer() const;
+    bool isAnswerCorrect(int index) const;
+    void setAnswerCorrect(int index, bool correct);
     
     // Wrong answers tracking
     void addWrongAnswer(int index);
-    QList<Question> getWrongAnswers() const { return m_wrongAnswers; }
-    QVector<int> getWrongAnswerIndices() const { return m_wrongAnswerIndices; }
+    const QList<Question> &getWrongAnswers() const { return m_wrongAnswers; }
+    const QVector<int> &getWrongAnswerIndices() const { return m_wrongAnswerIndices; }
     void clearWrongAnswers() { m_wrongAnswers.clear(); m_wrongAnswerIndices.clear(); }
     
     // Statistics
@@ -85,9 +92,7 @@ signals:
     
 private:
     QList<Question> m_questions;
-    QVector<bool> m_answeredFlags;
-    QVector<QString> m_userAnswers;
-    QVector<QStringList> m_userMultiAnswers;
+    AnswerStore m_answers;
     QList<Question> m_wrongAnswers;
     QVector<int> m_wrongAnswerIndices;
     
@@ -96,6 +101,7 @@ private:
     int m_wrongCount;
     
     void initializeAnswerTracking();
+    void onQuestionsReplaced();
     bool isValidIndex(int index) const;
 };
 
@@ -0,0 +1,190 @@
+#include "sessionjournal.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// 累计这么多条记录或等待这么久后落盘一次
+static const int kSyncBatchSize = 8;
+static const int kSyncIntervalMs = 1000;
+
+static void syncFileToDisk(QFile &file)
+{
+    file.flush();
+#ifdef Q_OS_WIN
+    _commit(file.handle());
+#else
+    ::fsync(file.handle());
+#endif
+}
+
+SessionJournal::SessionJournal(QObject *parent)
+    : QObject(parent)
+    , m_filePath("session.journal")
+    , m_baseSize(0)
+    , m_unsynced(0)
+    , m_syncTimer(new QTimer(this))
+{
+    m_syncTimer->setSingleShot(true);
+    m_syncTimer->setInterval(kSyncIntervalMs);
+    connect(m_syncTimer, &QTimer::timeout, this, &SessionJournal::sync);
+}
+
+SessionJournal::~SessionJournal()
+{
+    close();
+}
+
+bool SessionJournal::start(const QString &sessionId)
+{
+    close();
+
+    m_file.setFileName(m_filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Cannot open session journal:" << m_filePath << m_file.errorString();
+        return false;
+    }
+
+    QJsonObject header;
+    header["session"] = sessionId;
+    m_file.write(QJsonDocument(header).toJson(QJsonDocument::Compact) + '\n');
+    syncFileToDisk(m_file);
+
+    m_sessionId = sessionId;
+    m_baseSize = m_file.size();
+    m_unsynced = 0;
+    return true;
+}
+
+QList<SessionJournal::Record> SessionJournal::resume(const QString &sessionId)
+{
+    close();
+
+    QList<Record> records;
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        start(sessionId);
+        return records;
+    }
+
+    const QJsonObject header = QJsonDocument::fromJson(file.readLine()).object();
+    if (header.value("session").toString() != sessionId) {
+        file.close();
+        start(sessionId);
+        return records;
+    }
+
+    // 只保留完整的记录，崩溃时写了一半的最后一行被截掉
+    qint64 validSize = file.pos();
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine();
+        if (!line.endsWith('\n')) {
+            break;
+        }
+        const QJsonObject object = QJsonDocument::fromJson(line).object();
+        if (object.isEmpty() || !object.contains("i")) {
+            break;
+        }
+
+        Record record;
+        record.index = object.value("i").toInt(-1);
+        record.answer = object.value("a").toString();
+        for (const QJsonValue &value : object.value("m").toArray()) {
+            record.answers.append(value.toString());
+        }
+        record.correct = object.value("c").toBool();
+        record.timestamp = static_cast<qint64>(object.value("t").toDouble());
+        records.append(record);
+        validSize = file.pos();
+    }
+    file.close();
+
+    m_file.setFileName(m_filePath);
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        qWarning() << "Cannot open session journal:" << m_filePath << m_file.errorString();
+        return records;
+    }
+    if (m_file.size() != validSize) {
+        m_file.resize(validSize);
+    }
+    m_file.seek(validSize);
+
+    m_sessionId = sessionId;
+    m_baseSize = validSize;
+    m_unsynced = 0;
+    return records;
+}
+
+void SessionJournal::append(const Record &record)
+{
+    if (!isActive()) {
+        return;
+    }
+
+    QJsonObject object;
+    object["i"] = record.index;
+    if (!record.answer.isEmpty()) {
+        object["a"] = record.answer;
+    }
+    if (!record.answers.isEmpty()) {
+        object["m"] = QJsonArray::fromStringList(record.answers);
+    }
+    object["c"] = record.correct;
+    object["t"] = static_cast<double>(record.timestamp > 0 ? record.timestamp
+                                                           : QDateTime::currentMSecsSinceEpoch());
+
+    // 写入后立即交给操作系统，进程崩溃时记录不会丢失
+    m_file.write(QJsonDocument(object).toJson(QJsonDocument::Compact) + '\n');
+    m_file.flush();
+
+    if (++m_unsynced >= kSyncBatchSize) {
+        sync();
+    } else if (!m_syncTimer->isActive()) {
+        m_syncTimer->start();
+    }
+}
+
+void SessionJournal::rollback()
+{
+    if (!isActive()) {
+        return;
+    }
+    m_syncTimer->stop();
+    m_file.resize(m_baseSize);
+    m_file.seek(m_baseSize);
+    syncFileToDisk(m_file);
+    m_unsynced = 0;
+}
+
+void SessionJournal::sync()
+{
+    m_syncTimer->stop();
+    if (isActive() && m_unsynced > 0) {
+        syncFileToDisk(m_file);
+    }
+    m_unsynced = 0;
+}
+
+void SessionJournal::close()
+{
+    if (isActive()) {
+        sync();
+        m_file.close();
+    }
+    m_sessionId.clear();
+    m_baseSize = 0;
+}
+
+void SessionJournal::remove()
+{
+    close();
+    QFile::remove(m_filePath);
+}
@@ -0,0 +1,78 @@
+#ifndef SESSIONJOURNAL_H
+#define SESSIONJOURNAL_H
+
+#include <QObject>
+#include <QFile>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+class QTimer;
+
+/**
+ * 练习会话的作答日志
+ *
+ * 存档（checkpoint.json）只在开始练习和主动保存时完整写入，
+ * 之后每次提交答案只向日志文件末尾追加一行记录，写入开销与题目数量无关。
+ * 每条记录写入后立即交给操作系统，程序崩溃不会丢失；落盘（fsync）按批次进行。
+ * 恢复练习时先加载存档，再按顺序重放会话标识匹配的日志记录。
+ *
+ * 文件格式为每行一个JSON对象：第一行是 {"session": 会话标识}，
+ * 之后每行是一条作答记录 {"i": 题目序号, "a": 答案, "m": [填空答案], "c": 是否答对, "t": 时间戳}。
+ */
+class SessionJournal : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Record {
+        int index;              // 题目在会话中的序号
+        QString answer;         // 单选/判断/多选答案
+        QStringList answers;    // 填空答案
+        bool correct;
+        qint64 timestamp;       // 提交时间（毫秒）
+
+        Record() : index(-1), correct(false), timestamp(0) {}
+    };
+
+    explicit SessionJournal(QObject *parent = nullptr);
+    ~SessionJournal();
+
+    void setFilePath(const QString &filePath) { m_filePath = filePath; }
+    QString filePath() const { return m_filePath; }
+
+    /**
+     * @brief 开始新会话的日志，清空原有内容
+     */
+    bool start(const QString &sessionId);
+
+    /**
+     * @brief 继续已有会话的日志
+     * @return 会话标识匹配时返回已记录的作答，不匹配或文件损坏时重新开始并返回空列表
+     */
+    QList<Record> resume(const QString &sessionId);
+
+    void append(const Record &record);
+
+    /**
+     * @brief 丢弃本次start/resume之后追加的记录
+     */
+    void rollback();
+
+    void sync();
+    void close();
+    void remove();
+
+    bool isActive() const { return m_file.isOpen(); }
+    QString sessionId() const { return m_sessionId; }
+
+private:
+    QString m_filePath;
+    QString m_sessionId;
+    QFile m_file;
+    qint64 m_baseSize;      // start/resume时的文件长度，rollback截断到这里
+    int m_unsynced;         // 尚未落盘的记录数
+    QTimer *m_syncTimer;
+};
+
+#endif // SESSIONJOURNAL_H
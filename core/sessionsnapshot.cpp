@@ -0,0 +1,129 @@
+#include "sessionsnapshot.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+#include <QSaveFile>
+
+static const quint32 kSnapshotMagic = 0x50585353;   // "PXSS"
+static const quint32 kSnapshotVersion = 1;
+
+// 固定流版本，Qt5和Qt6构建写出的快照可以互相读取
+static const QDataStream::Version kStreamVersion = QDataStream::Qt_5_12;
+
+SessionSnapshot::SessionSnapshot()
+    : currentIndex(0)
+    , elapsedSeconds(0)
+    , correctCount(0)
+    , wrongCount(0)
+{
+}
+
+bool SessionSnapshot::save(const QString &filePath) const
+{
+    QByteArray payload;
+    {
+        QDataStream stream(&payload, QIODevice::WriteOnly);
+        stream.setVersion(kStreamVersion);
+        stream << sessionId << qint32(currentIndex) << elapsedSeconds;
+
+        // Question的流运算符不包含来源，紧跟在每道题后面写入
+        stream << qint32(questions.size());
+        for (const Question &question : questions) {
+            stream << question << question.getSourceBank() << qint32(question.getSourceIndex());
+        }
+
+        stream << answeredFlags << userAnswers << userMultiAnswers << correctFlags
+               << qint32(correctCount) << qint32(wrongCount);
+    }
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Cannot write session snapshot:" << filePath << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(kStreamVersion);
+    stream << kSnapshotMagic << kSnapshotVersion << payload
+           << QCryptographicHash::hash(payload, QCryptographicHash::Sha1);
+
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        qWarning() << "Failed to write session snapshot:" << filePath << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool SessionSnapshot::load(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream fileStream(&file);
+    fileStream.setVersion(kStreamVersion);
+    quint32 magic = 0;
+    quint32 version = 0;
+    fileStream >> magic >> version;
+    if (magic != kSnapshotMagic || version != kSnapshotVersion) {
+        qDebug() << "Ignoring session snapshot with unknown format:" << filePath;
+        return false;
+    }
+
+    QByteArray payload;
+    QByteArray checksum;
+    fileStream >> payload >> checksum;
+    if (fileStream.status() != QDataStream::Ok
+        || checksum != QCryptographicHash::hash(payload, QCryptographicHash::Sha1)) {
+        qWarning() << "Session snapshot is corrupted:" << filePath;
+        return false;
+    }
+
+    QDataStream stream(payload);
+    stream.setVersion(kStreamVersion);
+
+    SessionSnapshot snapshot;
+    qint32 index = 0;
+    qint32 count = 0;
+    stream >> snapshot.sessionId >> index >> snapshot.elapsedSeconds >> count;
+    snapshot.currentIndex = index;
+    if (stream.status() != QDataStream::Ok || count < 0) {
+        return false;
+    }
+
+    snapshot.questions.reserve(count);
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        Question question;
+        QString sourceBank;
+        qint32 sourceIndex = -1;
+        stream >> question >> sourceBank >> sourceIndex;
+        question.setSource(sourceBank, sourceIndex);
+        snapshot.questions.append(question);
+    }
+
+    qint32 correctCount = 0;
+    qint32 wrongCount = 0;
+    stream >> snapshot.answeredFlags >> snapshot.userAnswers >> snapshot.userMultiAnswers
+           >> snapshot.correctFlags >> correctCount >> wrongCount;
+    snapshot.correctCount = correctCount;
+    snapshot.wrongCount = wrongCount;
+
+    if (stream.status() != QDataStream::Ok
+        || snapshot.answeredFlags.size() != count
+        || snapshot.userAnswers.size() != count
+        || snapshot.userMultiAnswers.size() != count
+        || snapshot.correctFlags.size() != count) {
+        qWarning() << "Session snapshot is incomplete:" << filePath;
+        return false;
+    }
+
+    *this = snapshot;
+    return true;
+}
+
+void SessionSnapshot::remove(const QString &filePath)
+{
+    QFile::remove(filePath);
+}
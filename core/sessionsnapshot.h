@@ -0,0 +1,49 @@
+#ifndef SESSIONSNAPSHOT_H
+#define SESSIONSNAPSHOT_H
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "../models/question.h"
+
+/**
+ * 练习会话的二进制快照
+ *
+ * 暂停和保存存档时把整个会话（题目、作答状态、统计和计时）用QDataStream写入一个文件，
+ * 恢复练习时直接读取，不再逐字段解析JSON存档、也不需要重新加载题库。
+ * 快照只是加速用的缓存：会话标识与存档不一致、版本不符或校验失败时忽略，回退到JSON存档。
+ *
+ * 文件格式：魔数、格式版本、数据块（QByteArray）、数据块的SHA-1。
+ * 写入使用QSaveFile，中途失败不会留下不完整的文件。
+ */
+class SessionSnapshot
+{
+public:
+    SessionSnapshot();
+
+    QString sessionId;
+    int currentIndex;
+    qint64 elapsedSeconds;          // 不含暂停的作答用时
+
+    QList<Question> questions;      // 含题目来源
+    QVector<bool> answeredFlags;
+    QVector<QString> userAnswers;
+    QVector<QStringList> userMultiAnswers;
+    QVector<bool> correctFlags;
+    int correctCount;
+    int wrongCount;
+
+    bool save(const QString &filePath = defaultFilePath()) const;
+
+    /**
+     * @brief 读取快照
+     * @return 文件不存在、版本不符、校验失败或数据不完整时返回false
+     */
+    bool load(const QString &filePath = defaultFilePath());
+
+    static QString defaultFilePath() { return "session.snapshot"; }
+    static void remove(const QString &filePath = defaultFilePath());
+};
+
+#endif // SESSIONSNAPSHOT_H
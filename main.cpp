@@ -1,9 +1,13 @@
 #include "mainwindow.h"
+#include "utils/resourceschemehandler.h"
 
 #include <QApplication>
 
 int main(int argc, char *argv[])
 {
+    // 自定义协议必须在创建QApplication之前注册
+    ResourceSchemeHandler::registerScheme();
+    
     QApplication a(argc, argv);
     MainWindow w;
     w.show();
@@ -9,10 +9,26 @@
 #include "core/practicemanager.h"
 #include "models/question.h"
 #include "core/wronganswerset.h"
+#include "utils/bankwatcher.h"
+#include "utils/markdownrendererpool.h"
+#include "utils/mathprerenderer.h"
+#include "utils/resourceschemehandler.h"
 #include <QApplication>
 #include <QMessageBox>
+#include <QProgressDialog>
 #include <QCloseEvent>
 #include <QDebug>
+#include <QMap>
+#include <QTimer>
+
+// 开始界面显示后等待这么久再在空闲时预先创建其他界面
+static const int kWarmUpDelayMs = 500;
+
+// 界面创建完成后在空闲时预热的渲染器数量（题目页面和预取的相邻题目），不超过对象池容量
+static const int kPrewarmedRenderers = 3;
+
+// 加载题目超过这么久才显示进度对话框，小题库不闪现对话框
+static const int kLoadingDialogDelayMs = 300;
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -28,6 +44,8 @@ MainWindow::MainWindow(QWidget *parent)
     , m_configManager(nullptr)
     , m_practiceManager(nullptr)
     , m_wrongAnswerSet(nullptr)
+    , m_bankWatcher(nullptr)
+    , m_loadingDialog(nullptr)
 {
     ui->setupUi(this);
     
@@ -42,6 +60,17 @@ MainWindow::MainWindow(QWidget *parent)
     
     // Show start widget by default
     showStartWidget();
+    
+    // 题库的加载和扫描不阻塞开始界面的第一次显示
+    QTimer::singleShot(kWarmUpDelayMs, this, [this]() {
+        m_startWidget->loadButtonStates();
+        m_bankWatcher->setConfigManager(m_configManager);
+    });
+    
+    // 开始界面绘制完成后逐个创建常用界面，设置PROBLEMX_NO_WARMUP时完全按需创建
+    if (!qEnvironmentVariableIsSet("PROBLEMX_NO_WARMUP")) {
+        QTimer::singleShot(kWarmUpDelayMs, this, &MainWindow::warmUpNextScreen);
+    }
 }
 
 MainWindow::~MainWindow()
@@ -64,6 +93,38 @@ void MainWindow::initializeManagers()
     m_practiceManager = new PracticeManager(this);
     m_practiceManager->setWrongAnswerSet(m_wrongAnswerSet);
     // PracticeManager doesn't need setConfigManager, it receives ConfigManager as parameter in methods
+    
+    // Watch subject directories for external bank changes
+    // 开始监听需要科目列表（会加载并扫描题库），由构造函数推迟到开始界面显示之后
+    m_bankWatcher = new BankWatcher(this);
+    
+    // 渲染器对象池的容量可在config.json中配置
+    MarkdownRendererPool::instance()->setCapacity(m_configManager->getRendererPoolSize());
+}
+
+void MainWindow::prerenderSubjectMath(const QString &subject)
+{
+    if (subject.isEmpty()) {
+        return;
+    }
+    
+    // 题目已经在内存中，按来源题库分组，不再重新读取题库文件
+    // 组内按题库中的顺序排列，和整个题库的内容指纹一致，题库内容未变时预渲染器会直接跳过
+    QMap<QString, QMap<int, const Question *>> questionsByBank;
+    for (const Question &question : m_practiceManager->getQuestionManager()->getAllQuestions()) {
+        if (!question.getSourceBank().isEmpty()) {
+            questionsByBank[question.getSourceBank()].insert(question.getSourceIndex(), &question);
+        }
+    }
+    
+    for (auto bankIt = questionsByBank.constBegin(); bankIt != questionsByBank.constEnd(); ++bankIt) {
+        QStringList texts;
+        for (const Question *question : bankIt.value()) {
+            texts.append(question->getQuestion());
+            texts.append(question->getChoices());
+        }
+        MathPrerenderer::instance()->prerenderBank(subject + "/" + bankIt.key(), texts);
+    }
 }
 
 void MainWindow::setupUI()
@@ -78,33 +139,117 @@ void MainWindow::setupUI()
     m_stackedWidget = new QStackedWidget();
     m_mainLayout->addWidget(m_stackedWidget);
     
-    // Create widgets
+    // 启动时只创建开始界面，其他界面由ensure*()在第一次进入时创建
     m_startWidget = new StartWidget();
     m_startWidget->setConfigManager(m_configManager);
+    m_stackedWidget->addWidget(m_startWidget);
+    
+    // Set central widget
+    setCentralWidget(m_centralWidget);
+}
+
+ConfigWidget *MainWindow::ensureConfigWidget()
+{
+    if (m_configWidget) {
+        return m_configWidget;
+    }
     
     m_configWidget = new ConfigWidget();
     m_configWidget->setConfigManager(m_configManager);
+    m_stackedWidget->addWidget(m_configWidget);
+    
+    connect(m_configWidget, &ConfigWidget::backRequested,
+            this, &MainWindow::showStartWidget);
+    connect(m_configWidget, &ConfigWidget::configurationChanged, this, [this]() {
+        // 科目可能增删，同步监听路径并让题库索引失效
+        m_bankWatcher->syncWatchedSubjects();
+        if (m_questionAssistantWidget) {
+            m_questionAssistantWidget->markIndexStale();
+        }
+    });
+    
+    return m_configWidget;
+}
+
+PracticeWidget *MainWindow::ensurePracticeWidget()
+{
+    if (m_practiceWidget) {
+        return m_practiceWidget;
+    }
     
     m_practiceWidget = new PracticeWidget();
     m_practiceWidget->setPracticeManager(m_practiceManager);
+    m_stackedWidget->addWidget(m_practiceWidget);
+    
+    connect(m_practiceWidget, &PracticeWidget::practiceFinished,
+            this, &MainWindow::onPracticeFinished);
+    // practiceAborted signal doesn't exist, using backRequested instead
+    connect(m_practiceWidget, &PracticeWidget::backRequested,
+            this, &MainWindow::onPracticeAbandoned);
+    connect(m_practiceWidget, &PracticeWidget::saveAndExitRequested,
+            this, &MainWindow::onSaveAndExit);
+    connect(m_practiceWidget, &PracticeWidget::practiceCompletedAndClearSave,
+            this, &MainWindow::onPracticeCompletedAndClearSave);
+    
+    return m_practiceWidget;
+}
+
+ReviewWidget *MainWindow::ensureReviewWidget()
+{
+    if (m_reviewWidget) {
+        return m_reviewWidget;
+    }
     
     m_reviewWidget = new ReviewWidget();
     m_reviewWidget->setConfigManager(m_configManager);
     m_reviewWidget->setPracticeManager(m_practiceManager);
     m_reviewWidget->setWrongAnswerSet(m_wrongAnswerSet);
+    m_stackedWidget->addWidget(m_reviewWidget);
+    
+    connect(m_reviewWidget, &ReviewWidget::backRequested,
+            this, &MainWindow::showStartWidget);
+    connect(m_reviewWidget, &ReviewWidget::startReviewRequested,
+            this, &MainWindow::startReview);
+    
+    return m_reviewWidget;
+}
 
+QuestionAssistantWidget *MainWindow::ensureQuestionAssistantWidget()
+{
+    if (m_questionAssistantWidget) {
+        return m_questionAssistantWidget;
+    }
+    
     m_questionAssistantWidget = new QuestionAssistantWidget();
     m_questionAssistantWidget->setConfigManager(m_configManager);
-    
-    // Add widgets to stacked widget
-    m_stackedWidget->addWidget(m_startWidget);
-    m_stackedWidget->addWidget(m_configWidget);
-    m_stackedWidget->addWidget(m_practiceWidget);
-    m_stackedWidget->addWidget(m_reviewWidget);
     m_stackedWidget->addWidget(m_questionAssistantWidget);
     
-    // Set central widget
-    setCentralWidget(m_centralWidget);
+    connect(m_questionAssistantWidget, &QuestionAssistantWidget::backRequested,
+            this, &MainWindow::showStartWidget);
+    
+    return m_questionAssistantWidget;
+}
+
+void MainWindow::warmUpNextScreen()
+{
+    // 每次只创建一个界面，创建之间回到事件循环，不影响开始界面的响应
+    // 题目助手包含网页视图，只在用户进入时创建
+    if (!m_practiceWidget) {
+        ensurePracticeWidget();
+    } else if (!m_reviewWidget) {
+        ensureReviewWidget();
+    } else if (!m_configWidget) {
+        ensureConfigWidget();
+    } else {
+        // 界面都已创建，每次预热一个渲染器，直到达到目标数量
+        MarkdownRendererPool *pool = MarkdownRendererPool::instance();
+        const int target = qMin(kPrewarmedRenderers, pool->capacity());
+        if (pool->idleCount() >= target) {
+            return;
+        }
+        pool->prewarm(pool->idleCount() + 1);
+    }
+    QTimer::singleShot(0, this, &MainWindow::warmUpNextScreen);
 }
 
 void MainWindow::setupConnections()
@@ -120,33 +265,24 @@ void MainWindow::setupConnections()
     connect(m_startWidget, &StartWidget::exitRequested,
             this, &MainWindow::close);
     
-    // Config widget connections
-    connect(m_configWidget, &ConfigWidget::backRequested,
-            this, &MainWindow::showStartWidget);
+    // 其他界面的信号在ensure*()创建界面时连接
     
-    // Practice widget connections
-    connect(m_practiceWidget, &PracticeWidget::practiceFinished,
-            this, &MainWindow::onPracticeFinished);
-    // practiceAborted signal doesn't exist, using backRequested instead
-    connect(m_practiceWidget, &PracticeWidget::backRequested,
-            this, &MainWindow::showStartWidget);
-    connect(m_practiceWidget, &PracticeWidget::saveAndExitRequested,
-            this, &MainWindow::onSaveAndExit);
-    connect(m_practiceWidget, &PracticeWidget::practiceCompletedAndClearSave,
-            this, &MainWindow::onPracticeCompletedAndClearSave);
-    
-    // Review widget connections
-    connect(m_reviewWidget, &ReviewWidget::backRequested,
-            this, &MainWindow::showStartWidget);
-    connect(m_reviewWidget, &ReviewWidget::startReviewRequested,
-            this, &MainWindow::startReview);
-
-    connect(m_questionAssistantWidget, &QuestionAssistantWidget::backRequested,
-            this, &MainWindow::showStartWidget);
+    // Bank watcher connections
+    connect(m_bankWatcher, &BankWatcher::subjectBanksChanged,
+            this, &MainWindow::onSubjectBanksChanged);
     
     // Practice manager connections
     connect(m_practiceManager, &PracticeManager::practiceStarted,
             this, &MainWindow::showPracticeWidget);
+    connect(m_practiceManager, &PracticeManager::questionLoadingProgress,
+            this, &MainWindow::onQuestionLoadingProgress);
+    connect(m_practiceManager, &PracticeManager::questionLoadingFinished,
+            this, &MainWindow::onQuestionLoadingFinished);
+    // 错题导入询问由复习界面处理，复习界面此时可能还没有创建
+    connect(m_practiceManager, &PracticeManager::wrongAnswersImportRequested,
+            this, [this](const QList<Question> &wrongQuestions, const QString &subject) {
+                ensureReviewWidget()->onWrongAnswersImportRequested(wrongQuestions, subject);
+            });
 }
 
 void MainWindow::showStartWidget()
@@ -157,36 +293,33 @@ void MainWindow::showStartWidget()
 
 void MainWindow::showConfigWidget()
 {
-    m_stackedWidget->setCurrentWidget(m_configWidget);
+    m_stackedWidget->setCurrentWidget(ensureConfigWidget());
     setWindowTitle("ProblemX - 配置管理");
 }
 
 void MainWindow::showPracticeWidget()
 {
-    m_stackedWidget->setCurrentWidget(m_practiceWidget);
+    m_stackedWidget->setCurrentWidget(ensurePracticeWidget());
     setWindowTitle("ProblemX - 练习中");
 }
 
 void MainWindow::showReviewWidget()
 {
-    m_stackedWidget->setCurrentWidget(m_reviewWidget);
+    m_stackedWidget->setCurrentWidget(ensureReviewWidget());
     setWindowTitle("ProblemX - 错题复习");
     
     // 自动加载错题数据
-    if (m_reviewWidget) {
-        m_reviewWidget->loadWrongAnswers();
-    }
+    m_reviewWidget->loadWrongAnswers();
 }
 
 void MainWindow::showQuestionAssistantWidget()
 {
-    if (m_questionAssistantWidget) {
-        m_questionAssistantWidget->setConfigManager(m_configManager);
-        if (!m_questionAssistantWidget->prepareForShow()) {
-            return;
-        }
+    QuestionAssistantWidget *assistantWidget = ensureQuestionAssistantWidget();
+    assistantWidget->setConfigManager(m_configManager);
+    if (!assistantWidget->prepareForShow()) {
+        return;
     }
-    m_stackedWidget->setCurrentWidget(m_questionAssistantWidget);
+    m_stackedWidget->setCurrentWidget(assistantWidget);
     setWindowTitle("ProblemX - 题目助手");
 }
 
@@ -202,6 +335,10 @@ void MainWindow::startPractice()
         return;
     }
     
+    if (m_practiceManager->isLoadingQuestions()) {
+        return;
+    }
+    
     // Check if there are any subjects configured
     QStringList subjects = m_configManager->getSubjects();
     if (subjects.isEmpty()) {
@@ -261,14 +398,49 @@ void MainWindow::startPractice()
         }
     }
     
-    if (m_practiceManager->startNewPractice(currentSubject, m_configManager)) {
-        showPracticeWidget();
-        // 启动练习界面显示
-        m_practiceWidget->startPractice();
-    } else {
+    // 题目在后台线程加载，完成后由onQuestionLoadingFinished进入练习界面
+    if (!m_practiceManager->startNewPracticeAsync(currentSubject, m_configManager)) {
         QMessageBox::warning(this, "错误", 
             QString("无法开始练习，请检查题库配置\n\n科目: %1\n请确保该科目有已启用的题库。")
             .arg(currentSubject));
+        return;
+    }
+    
+    m_loadingDialog = new QProgressDialog("正在加载题库...", "取消", 0, 0, this);
+    m_loadingDialog->setWindowTitle("开始练习");
+    m_loadingDialog->setWindowModality(Qt::WindowModal);
+    m_loadingDialog->setMinimumDuration(kLoadingDialogDelayMs);
+    m_loadingDialog->setAutoClose(false);
+    m_loadingDialog->setAutoReset(false);
+    connect(m_loadingDialog, &QProgressDialog::canceled,
+            m_practiceManager, &PracticeManager::cancelQuestionLoading);
+}
+
+void MainWindow::onQuestionLoadingProgress(int loadedBanks, int totalBanks)
+{
+    if (m_loadingDialog) {
+        m_loadingDialog->setMaximum(totalBanks);
+        m_loadingDialog->setValue(loadedBanks);
+        m_loadingDialog->setLabelText(QString("正在加载题库... (%1/%2)").arg(loadedBanks).arg(totalBanks));
+    }
+}
+
+void MainWindow::onQuestionLoadingFinished(const QString &subject, bool success, bool canceled)
+{
+    if (m_loadingDialog) {
+        m_loadingDialog->deleteLater();
+        m_loadingDialog = nullptr;
+    }
+    
+    if (success) {
+        // practiceStarted已切换到练习界面
+        ensurePracticeWidget()->startPractice();
+        // 第一道题显示之后再提取公式，不推迟练习界面出现
+        QTimer::singleShot(0, this, [this, subject]() { prerenderSubjectMath(subject); });
+    } else if (!canceled) {
+        QMessageBox::warning(this, "错误", 
+            QString("无法开始练习，请检查题库配置\n\n科目: %1\n请确保该科目有已启用的题库。")
+            .arg(subject));
     }
 }
 
@@ -288,7 +460,7 @@ void MainWindow::startReview(const QList<Question> &questions)
     if (m_practiceManager->startReviewPractice(questions)) {
         showPracticeWidget();
         // 启动练习界面显示
-        m_practiceWidget->startPractice();
+        ensurePracticeWidget()->startPractice();
     } else {
         QMessageBox::warning(this, "错误", "无法开始复习");
     }
@@ -305,7 +477,9 @@ void MainWindow::resumePractice()
     if (m_practiceManager->resumePractice(m_configManager)) {
         showPracticeWidget();
         // 启动练习界面显示
-        m_practiceWidget->startPractice();
+        ensurePracticeWidget()->startPractice();
+        const QString subject = m_configManager->getCurrentSubject();
+        QTimer::singleShot(0, this, [this, subject]() { prerenderSubjectMath(subject); });
     } else {
         QMessageBox::warning(this, "错误", "无法恢复练习，可能没有保存的进度");
     }
@@ -337,6 +511,20 @@ void MainWindow::onSaveAndExit()
     QMessageBox::information(this, "保存成功", "练习进度已保存，下次可以选择继续练习。");
 }
 
+void MainWindow::onPracticeAbandoned()
+{
+    // 练习过程中的作答会自动记录，不保存退出时需要撤销
+    if (m_practiceManager) {
+        m_practiceManager->abandonPractice();
+    }
+    
+    showStartWidget();
+    
+    if (m_startWidget) {
+        m_startWidget->checkForCheckpoint();
+    }
+}
+
 void MainWindow::onPracticeCompletedAndClearSave()
 {
     if (!m_configManager) {
@@ -353,4 +541,22 @@ void MainWindow::onPracticeCompletedAndClearSave()
     }
 }
 
+void MainWindow::onSubjectBanksChanged(const QString &subject)
+{
+    qDebug() << "Question banks changed on disk for subject:" << subject;
+    
+    // 题库索引在下次使用时重建
+    if (m_questionAssistantWidget) {
+        m_questionAssistantWidget->markIndexStale();
+    }
+    
+    // 题目图片可能被替换，丢弃内存中的图片缓存
+    ResourceSchemeHandler::clearImageCache();
+    
+    // 配置界面可见时立即刷新，否则在下次显示时自动刷新
+    if (m_configWidget && m_configWidget->isVisible()) {
+        m_configWidget->refreshData();
+    }
+}
+
 // onPracticeAborted method removed as practiceAborted signal doesn't exist
@@ -22,6 +22,8 @@ class QuestionAssistantWidget;
 class ConfigManager;
 class PracticeManager;
 class WrongAnswerSet;
+class BankWatcher;
+class QProgressDialog;
 
 class MainWindow : public QMainWindow
 {
@@ -42,7 +44,12 @@ private slots:
     void resumePractice();
     void onPracticeFinished();
     void onSaveAndExit();  // 处理保存并退出
+    void onPracticeAbandoned();  // 不保存直接退出练习
     void onPracticeCompletedAndClearSave();  // 练习完成并清除存档
+    void onSubjectBanksChanged(const QString &subject);  // 题库目录发生外部变化
+    void warmUpNextScreen();  // 空闲时预先创建一个尚未创建的界面
+    void onQuestionLoadingProgress(int loadedBanks, int totalBanks);
+    void onQuestionLoadingFinished(const QString &subject, bool success, bool canceled);
     // onPracticeAborted method removed as practiceAborted signal doesn't exist
 
 private:
@@ -50,6 +57,13 @@ private:
     void setupConnections();
     void initializeManagers();
     
+    // 除开始界面外的界面在第一次进入时才创建
+    ConfigWidget *ensureConfigWidget();
+    PracticeWidget *ensurePracticeWidget();
+    ReviewWidget *ensureReviewWidget();
+    QuestionAssistantWidget *ensureQuestionAssistantWidget();
+    void prerenderSubjectMath(const QString &subject);  // 按来源题库预渲染当前练习题目中的公式
+    
     Ui::MainWindow *ui;
     QWidget *m_centralWidget;
     QVBoxLayout *m_mainLayout;
@@ -66,6 +80,9 @@ private:
     ConfigManager *m_configManager;
     PracticeManager *m_practiceManager;
     WrongAnswerSet *m_wrongAnswerSet;
+    BankWatcher *m_bankWatcher;
+    
+    QProgressDialog *m_loadingDialog;  // 开始练习时加载题目的进度
 };
 
 #endif // MAINWINDOW_H
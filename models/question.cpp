@@ -1,41 +1,50 @@
 #include "question.h"
+#include "../utils/textnormalize.h"
 #include <QJsonArray>
+#include <QCryptographicHash>
 #include <QDebug>
 
 Question::Question()
     : m_type(QuestionType::Choice)
     , m_blankNum(0)
+    , m_sourceIndex(-1)
 {
 }
 
 Question::Question(const QJsonObject &json)
     : m_blankNum(0)
+    , m_sourceIndex(-1)
 {
     fromJson(json);
 }
 
+static bool matchesAnyKey(const QString &userAnswer, const QStringList &keys)
+{
+    for (const QString &key : keys) {
+        if (TextNormalize::matchesNormalizedAnswer(userAnswer, key)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool Question::checkAnswer(const QString &userAnswer) const
 {
-    if (m_answers.isEmpty()) {
+    if (m_answerKeys.isEmpty()) {
         return false;
     }
     
-    QString trimmedAnswer = userAnswer.trimmed().toUpper();
-    QString correctAnswer = m_answers.first().trimmed().toUpper();
-    
-    return trimmedAnswer == correctAnswer;
+    return matchesAnyKey(userAnswer, m_answerKeys.first());
 }
 
 bool Question::checkAnswers(const QStringList &userAnswers) const
 {
-    if (userAnswers.size() != m_answers.size()) {
+    if (userAnswers.size() != m_answerKeys.size()) {
         return false;
     }
     
     for (int i = 0; i < userAnswers.size(); ++i) {
-        QString userAns = userAnswers[i].trimmed();
-        QString correctAns = m_answers[i].trimmed();
-        if (userAns != correctAns) {
+        if (!matchesAnyKey(userAnswers[i], m_answerKeys[i])) {
             return false;
         }
     }
@@ -43,6 +52,26 @@ bool Question::checkAnswers(const QStringList &userAnswers) const
     return true;
 }
 
+void Question::rebuildAnswerKeys()
+{
+    // 判题时只做逐字符比较，规范化工作在加载/修改答案时一次完成
+    m_answerKeys.clear();
+    m_answerKeys.reserve(m_answers.size());
+    for (int i = 0; i < m_answers.size(); ++i) {
+        QStringList keys;
+        keys.append(TextNormalize::normalizeAnswer(m_answers[i]));
+        if (i < m_answerAlternatives.size()) {
+            for (const QString &alternative : m_answerAlternatives[i]) {
+                const QString key = TextNormalize::normalizeAnswer(alternative);
+                if (!key.isEmpty() && !keys.contains(key)) {
+                    keys.append(key);
+                }
+            }
+        }
+        m_answerKeys.append(keys);
+    }
+}
+
 QJsonObject Question::toJson() const
 {
     QJsonObject json;
@@ -60,8 +89,18 @@ QJsonObject Question::toJson() const
     if (m_type == QuestionType::FillBlank) {
         json["BlankNum"] = m_blankNum;
         QJsonArray answersArray;
-        for (const QString &answer : m_answers) {
-            answersArray.append(answer);
+        for (int i = 0; i < m_answers.size(); ++i) {
+            // 有备选答案的空写成数组：第一个为标准答案，其余为备选答案
+            if (i < m_answerAlternatives.size() && !m_answerAlternatives[i].isEmpty()) {
+                QJsonArray blankArray;
+                blankArray.append(m_answers[i]);
+                for (const QString &alternative : m_answerAlternatives[i]) {
+                    blankArray.append(alternative);
+                }
+                answersArray.append(blankArray);
+            } else {
+                answersArray.append(m_answers[i]);
+            }
         }
         json["answer"] = answersArray;
     } else {
@@ -99,12 +138,29 @@ void Question::fromJson(const QJsonObject &json)
     
     // Parse answers
     m_answers.clear();
+    m_answerAlternatives.clear();
     if (m_type == QuestionType::FillBlank) {
         m_blankNum = json["BlankNum"].toInt();
         if (json["answer"].isArray()) {
             QJsonArray answersArray = json["answer"].toArray();
+            bool hasAlternatives = false;
             for (const QJsonValue &value : answersArray) {
-                m_answers.append(value.toString());
+                // 某个空也可以写成数组 ["标准答案", "备选1", ...]
+                QStringList alternatives;
+                if (value.isArray()) {
+                    const QJsonArray blankArray = value.toArray();
+                    m_answers.append(blankArray.isEmpty() ? QString() : blankArray.first().toString());
+                    for (int i = 1; i < blankArray.size(); ++i) {
+                        alternatives.append(blankArray.at(i).toString());
+                    }
+                    hasAlternatives = hasAlternatives || !alternatives.isEmpty();
+                } else {
+                    m_answers.append(value.toString());
+                }
+                m_answerAlternatives.append(alternatives);
+            }
+            if (!hasAlternatives) {
+                m_answerAlternatives.clear();
             }
         }
     } else {
@@ -113,6 +169,7 @@ void Question::fromJson(const QJsonObject &json)
             m_answers.append(answer);
         }
     }
+    rebuildAnswerKeys();
     
     // Parse image path
     m_images.clear();
@@ -162,6 +219,15 @@ QString Question::typeToString(QuestionType type)
     return "Choice"; // Default
 }
 
+QByteArray Question::contentHash() const
+{
+    // 与QDataStream序列化的字段一致，来源信息不参与
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << *this;
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
 // Stream operators implementation
 QDebug operator<<(QDebug debug, const Question &question)
 {
@@ -178,7 +244,8 @@ QDataStream &operator<<(QDataStream &stream, const Question &question)
            << question.getChoices()
            << question.getAnswers()
            << question.getImages()
-           << question.getBlankNum();
+           << question.getBlankNum()
+           << question.getAnswerAlternatives();
     return stream;
 }
 
@@ -189,12 +256,14 @@ QDataStream &operator>>(QDataStream &stream, Question &question)
     QStringList choices, answers;
     QMap<QString, QString> images;
     int blankNum;
+    QVector<QStringList> alternatives;
     
-    stream >> type >> questionText >> choices >> answers >> images >> blankNum;
+    stream >> type >> questionText >> choices >> answers >> images >> blankNum >> alternatives;
     
     question.setType(static_cast<QuestionType>(type));
     question.setQuestion(questionText);
     question.setChoices(choices);
+    question.setAnswerAlternatives(alternatives);
     question.setAnswers(answers);
     question.setImages(images);
     question.setBlankNum(blankNum);
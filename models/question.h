@@ -5,6 +5,7 @@
 #include <QStringList>
 #include <QJsonObject>
 #include <QMap>
+#include <QVector>
 #include <QMetaType>
 #include <QDebug>
 #include <QDataStream>
@@ -28,16 +29,24 @@ public:
     QStringList getChoices() const { return m_choices; }
     QStringList getAnswers() const { return m_answers; }
     QString getSingleAnswer() const { return m_answers.isEmpty() ? "" : m_answers.first(); }
+    QVector<QStringList> getAnswerAlternatives() const { return m_answerAlternatives; }
     const QMap<QString, QString>& getImages() const { return m_images; }
     int getBlankNum() const { return m_blankNum; }
     bool hasImage() const { return !m_images.isEmpty(); }
     
+    // 来源：题库文件（配置中的src）和题目在文件data数组中的位置，不是从题库加载的题目为空
+    QString getSourceBank() const { return m_sourceBank; }
+    int getSourceIndex() const { return m_sourceIndex; }
+    bool hasSource() const { return !m_sourceBank.isEmpty() && m_sourceIndex >= 0; }
+    void setSource(const QString &bank, int index) { m_sourceBank = bank; m_sourceIndex = index; }
+    
     // Setters
     void setType(QuestionType type) { m_type = type; }
     void setQuestion(const QString &question) { m_question = question; }
     void setChoices(const QStringList &choices) { m_choices = choices; }
-    void setAnswers(const QStringList &answers) { m_answers = answers; }
-    void setSingleAnswer(const QString &answer) { m_answers = QStringList() << answer; }
+    void setAnswers(const QStringList &answers) { m_answers = answers; rebuildAnswerKeys(); }
+    void setSingleAnswer(const QString &answer) { m_answers = QStringList() << answer; rebuildAnswerKeys(); }
+    void setAnswerAlternatives(const QVector<QStringList> &alternatives) { m_answerAlternatives = alternatives; rebuildAnswerKeys(); }
     void setImages(const QMap<QString, QString> &images) { m_images = images; }
     void setBlankNum(int blankNum) { m_blankNum = blankNum; }
     
@@ -47,6 +56,9 @@ public:
     QJsonObject toJson() const;
     void fromJson(const QJsonObject &json);
     
+    // 题目内容（不含来源）的哈希，用于判断题库中的题目是否被修改
+    QByteArray contentHash() const;
+    
     static QuestionType stringToType(const QString &typeStr);
     static QString typeToString(QuestionType type);
     
@@ -57,6 +69,16 @@ private:
     QStringList m_answers;  // Can be single or multiple answers
     QMap<QString, QString> m_images;
     int m_blankNum;         // For fill blank questions
+    
+    QString m_sourceBank;
+    int m_sourceIndex;
+    
+    // 每个空可接受的其他答案（不含m_answers中的标准答案），仅填空题使用
+    QVector<QStringList> m_answerAlternatives;
+    // 加载时预先规范化的判题key：每个空一组，包含标准答案和全部备选答案
+    QVector<QStringList> m_answerKeys;
+    
+    void rebuildAnswerKeys();
 };
 
 // Qt Meta Type support
@@ -5,8 +5,26 @@
 #include <QFileInfo>
 #include <QDir>
 #include <QDebug>
+#include <QtConcurrent/QtConcurrentMap>
 #include <algorithm>
 #include <random>
+#include <utility>
+
+struct BankLoadTask {
+    QString subjectPath;
+    QuestionBankInfo bank;
+    bool shuffleQuestions;
+};
+
+static QList<Question> loadBankTask(const BankLoadTask &task)
+{
+    return QuestionBank().loadQuestionsFromBank(task.subjectPath, task.bank, task.shuffleQuestions);
+}
+
+static void appendBankQuestions(QList<Question> &result, const QList<Question> &bankQuestions)
+{
+    result.append(bankQuestions);
+}
 
 QuestionBank::QuestionBank()
 {
@@ -72,62 +90,61 @@ QList<Question> QuestionBank::loadSelectedQuestions(const QString &subjectPath,
     // Load from all selected banks
     for (const auto& bank : m_choiceBanks) {
         if (bank.chosen) {
-            auto questions = loadQuestionsFromBank(subjectPath, bank, shuffleQuestions);
-            allQuestions.append(questions);
+            allQuestions.append(loadQuestionsFromBank(subjectPath, bank, shuffleQuestions));
         }
     }
     
     for (const auto& bank : m_trueOrFalseBanks) {
         if (bank.chosen) {
-            auto questions = loadQuestionsFromBank(subjectPath, bank, shuffleQuestions);
-            allQuestions.append(questions);
+            allQuestions.append(loadQuestionsFromBank(subjectPath, bank, shuffleQuestions));
         }
     }
     
     for (const auto& bank : m_fillBlankBanks) {
         if (bank.chosen) {
-            auto questions = loadQuestionsFromBank(subjectPath, bank, shuffleQuestions);
-            allQuestions.append(questions);
+            allQuestions.append(loadQuestionsFromBank(subjectPath, bank, shuffleQuestions));
         }
     }
     
     if (shuffleQuestions) {
-        std::random_device rd;
-        std::mt19937 g(rd());
-        std::shuffle(allQuestions.begin(), allQuestions.end(), g);
+        shuffleQuestionOrder(allQuestions);
     }
     
     return allQuestions;
 }
 
-QList<Question> QuestionBank::loadQuestionsFromBank(const QString &subjectPath, const QuestionBankInfo &bank, bool shuffleQuestions) const
+QFuture<QList<Question>> QuestionBank::loadSelectedQuestionsAsync(const QString &subjectPath, bool shuffleQuestions) const
 {
-    QString filePath = QDir(subjectPath).filePath(bank.src);
-    if (!QFileInfo::exists(filePath)) {
-        QString typeFolder;
-        switch (bank.type) {
-        case QuestionType::Choice:
-            typeFolder = "Choice";
-            break;
-        case QuestionType::TrueOrFalse:
-            typeFolder = "TrueorFalse";
-            break;
-        case QuestionType::FillBlank:
-            typeFolder = "FillBlank";
-            break;
-        default:
-            typeFolder = "Choice";
-            break;
+    QList<BankLoadTask> tasks;
+    for (const QuestionBankInfo &bank : getAllBanks()) {
+        if (bank.chosen) {
+            tasks.append({subjectPath, bank, shuffleQuestions});
         }
-        filePath = QDir(subjectPath).filePath(typeFolder + "/" + bank.src);
     }
+    
+    // 按题库顺序归并，不乱序时题目顺序与同步加载一致
+    return QtConcurrent::mappedReduced(tasks, loadBankTask, appendBankQuestions,
+                                       QtConcurrent::OrderedReduce);
+}
 
-    QList<Question> loadedQuestions = loadQuestionsFromFile(filePath);
+void QuestionBank::shuffleQuestionOrder(QList<Question> &questions)
+{
+    std::random_device rd;
+    std::mt19937 g(rd());
+    std::shuffle(questions.begin(), questions.end(), g);
+}
+
+QList<Question> QuestionBank::loadQuestionsFromBank(const QString &subjectPath, const QuestionBankInfo &bank, bool shuffleQuestions) const
+{
+    const QString filePath = resolveBankFilePath(subjectPath, bank.src, bank.type);
+
+    // 逐题移动而非复制，避免题干、选项和图片表的重复分配
+    QList<Question> loadedQuestions = loadQuestionsFromFile(filePath, bank.src);
     QList<Question> allQuestions;
     allQuestions.reserve(loadedQuestions.size());
-    for (const auto &q : loadedQuestions) {
+    for (auto &q : loadedQuestions) {
         if (q.getType() == bank.type) {
-            allQuestions.append(q);
+            allQuestions.append(std::move(q));
         }
     }
     
@@ -147,10 +164,25 @@ QList<Question> QuestionBank::loadQuestionsFromBank(const QString &subjectPath,
 
 QList<Question> QuestionBank::loadAllQuestionsFromBank(const QString &subjectPath, const QuestionBankInfo &bank) const
 {
-    QString filePath = QDir(subjectPath).filePath(bank.src);
+    const QString filePath = resolveBankFilePath(subjectPath, bank.src, bank.type);
+
+    QList<Question> loadedQuestions = loadQuestionsFromFile(filePath, bank.src);
+    QList<Question> allQuestions;
+    allQuestions.reserve(loadedQuestions.size());
+    for (auto &q : loadedQuestions) {
+        if (q.getType() == bank.type) {
+            allQuestions.append(std::move(q));
+        }
+    }
+    return allQuestions;
+}
+
+QString QuestionBank::resolveBankFilePath(const QString &subjectPath, const QString &src, QuestionType type)
+{
+    QString filePath = QDir(subjectPath).filePath(src);
     if (!QFileInfo::exists(filePath)) {
         QString typeFolder;
-        switch (bank.type) {
+        switch (type) {
         case QuestionType::Choice:
             typeFolder = "Choice";
             break;
@@ -164,21 +196,12 @@ QList<Question> QuestionBank::loadAllQuestionsFromBank(const QString &subjectPat
             typeFolder = "Choice";
             break;
         }
-        filePath = QDir(subjectPath).filePath(typeFolder + "/" + bank.src);
-    }
-
-    const QList<Question> loadedQuestions = loadQuestionsFromFile(filePath);
-    QList<Question> allQuestions;
-    allQuestions.reserve(loadedQuestions.size());
-    for (const auto &q : loadedQuestions) {
-        if (q.getType() == bank.type) {
-            allQuestions.append(q);
-        }
+        filePath = QDir(subjectPath).filePath(typeFolder + "/" + src);
     }
-    return allQuestions;
+    return filePath;
 }
 
-QList<Question> QuestionBank::loadQuestionsFromFile(const QString &filePath) const
+QList<Question> QuestionBank::loadQuestionsFromFile(const QString &filePath, const QString &sourceBank) const
 {
     QList<Question> questions;
     
@@ -201,9 +224,12 @@ QList<Question> QuestionBank::loadQuestionsFromFile(const QString &filePath) con
     if (root.contains("data") && root["data"].isArray()) {
         QJsonArray dataArray = root["data"].toArray();
         const QString baseDir = QFileInfo(filePath).absolutePath();
-        for (const QJsonValue &value : dataArray) {
+        for (int i = 0; i < dataArray.size(); ++i) {
+            const QJsonValue value = dataArray.at(i);
             if (value.isObject()) {
                 Question question(value.toObject());
+                // 记录来源，存档时只保存引用
+                question.setSource(sourceBank, i);
                 if (question.hasImage()) {
                     QMap<QString, QString> images = question.getImages();
                     for (auto it = images.begin(); it != images.end(); ++it) {
@@ -221,7 +247,7 @@ QList<Question> QuestionBank::loadQuestionsFromFile(const QString &filePath) con
                     }
                     question.setImages(images);
                 }
-                questions.append(question);
+                questions.append(std::move(question));
             }
         }
     }
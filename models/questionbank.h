@@ -4,6 +4,7 @@
 #include <QString>
 #include <QStringList>
 #include <QJsonObject>
+#include <QFuture>
 #include <QVector>
 #include "question.h"
 
@@ -30,12 +31,14 @@ public:
     QVector<QuestionBankInfo> getTrueOrFalseBanks() const { return m_trueOrFalseBanks; }
     QVector<QuestionBankInfo> getFillBlankBanks() const { return m_fillBlankBanks; }
     QVector<QuestionBankInfo> getAllBanks() const;
+    const QVector<QuestionBankInfo> &getBanks(QuestionType type) const { return getBanksByType(type); }
     
     // Setters
     void setSubject(const QString &subject) { m_subject = subject; }
     void setChoiceBanks(const QVector<QuestionBankInfo> &banks) { m_choiceBanks = banks; }
     void setTrueOrFalseBanks(const QVector<QuestionBankInfo> &banks) { m_trueOrFalseBanks = banks; }
     void setFillBlankBanks(const QVector<QuestionBankInfo> &banks) { m_fillBlankBanks = banks; }
+    void setBanks(QuestionType type, const QVector<QuestionBankInfo> &banks) { getBanksByType(type) = banks; }
     
     // Bank management
     void addChoiceBank(const QuestionBankInfo &bank);
@@ -48,9 +51,16 @@ public:
     
     // Question loading
     QList<Question> loadSelectedQuestions(const QString &subjectPath, bool shuffleQuestions = true) const;
+    // 在线程池中并行加载已选题库，每个题库完成时推进一次进度，可以取消；
+    // 结果按题库顺序拼接，跨题库的乱序由调用方在得到结果后用shuffleQuestionOrder完成
+    QFuture<QList<Question>> loadSelectedQuestionsAsync(const QString &subjectPath, bool shuffleQuestions = true) const;
+    static void shuffleQuestionOrder(QList<Question> &questions);
     QList<Question> loadQuestionsFromBank(const QString &subjectPath, const QuestionBankInfo &bank, bool shuffleQuestions = true) const;
     QList<Question> loadAllQuestionsFromBank(const QString &subjectPath, const QuestionBankInfo &bank) const;
     
+    // 题库文件路径：先按src直接查找，不存在时再到题型目录中查找
+    static QString resolveBankFilePath(const QString &subjectPath, const QString &src, QuestionType type);
+    
     // JSON serialization
     QJsonObject toJson() const;
     void fromJson(const QJsonObject &json);
@@ -65,7 +75,7 @@ private:
     QVector<QuestionBankInfo> m_trueOrFalseBanks;
     QVector<QuestionBankInfo> m_fillBlankBanks;
     
-    QList<Question> loadQuestionsFromFile(const QString &filePath) const;
+    QList<Question> loadQuestionsFromFile(const QString &filePath, const QString &sourceBank) const;
     QVector<QuestionBankInfo>& getBanksByType(QuestionType type);
     const QVector<QuestionBankInfo>& getBanksByType(QuestionType type) const;
 };
@@ -0,0 +1,113 @@
+#include "questionlistmodel.h"
+#include "../core/questionmanager.h"
+#include <QColor>
+#include <QFont>
+
+QuestionListModel::QuestionListModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_questionManager(nullptr)
+    , m_rowCount(0)
+    , m_currentIndex(-1)
+{
+}
+
+void QuestionListModel::reset(const QuestionManager *questionManager, int currentIndex)
+{
+    beginResetModel();
+    m_questionManager = questionManager;
+    m_rowCount = questionManager ? questionManager->getQuestionCount() : 0;
+    m_currentIndex = currentIndex;
+    endResetModel();
+}
+
+void QuestionListModel::setCurrentIndex(int index)
+{
+    if (index == m_currentIndex) {
+        return;
+    }
+
+    const int previous = m_currentIndex;
+    m_currentIndex = index;
+    emitRowChanged(previous);
+    emitRowChanged(index);
+}
+
+void QuestionListModel::refreshQuestion(int index)
+{
+    emitRowChanged(index);
+}
+
+void QuestionListModel::emitRowChanged(int row)
+{
+    if (row < 0 || row >= m_rowCount) {
+        return;
+    }
+    const QModelIndex modelIndex = createIndex(row, 0);
+    emit dataChanged(modelIndex, modelIndex);
+}
+
+int QuestionListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rowCount;
+}
+
+QVariant QuestionListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || !m_questionManager || index.row() >= m_rowCount) {
+        return QVariant();
+    }
+
+    const int row = index.row();
+    if (role == QuestionIndexRole) {
+        return row;
+    }
+
+    // 当前题目优先于答题状态显示
+    const bool current = (row == m_currentIndex);
+    const bool answered = m_questionManager->isAnswered(row);
+    const bool correct = answered && m_questionManager->isAnswerCorrect(row);
+
+    switch (role) {
+        case Qt::DisplayRole: {
+            QString status;
+            if (current) {
+                status = "●";
+            } else if (answered) {
+                status = correct ? "✓" : "✗";
+            } else {
+                status = "○";
+            }
+            return QString("%1 %2").arg(row + 1).arg(status);
+        }
+        case Qt::BackgroundRole:
+            if (current) {
+                return QColor("#007bff");
+            }
+            if (answered) {
+                return correct ? QColor("#d4edda") : QColor("#f8d7da");
+            }
+            return QColor("white");
+        case Qt::ForegroundRole:
+            if (!current && answered) {
+                return correct ? QColor("#155724") : QColor("#721c24");
+            }
+            return QColor("black");
+        case Qt::FontRole:
+            if (current) {
+                QFont font;
+                font.setBold(true);
+                return font;
+            }
+            return QVariant();
+        case Qt::ToolTipRole:
+            if (current) {
+                return QString("当前题目 %1").arg(row + 1);
+            }
+            if (answered) {
+                return QString("题目 %1 - %2").arg(row + 1).arg(correct ? "答对" : "答错");
+            }
+            return QString("题目 %1 - 未答").arg(row + 1);
+        default:
+            return QVariant();
+    }
+}
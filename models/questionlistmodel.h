@@ -0,0 +1,54 @@
+#ifndef QUESTIONLISTMODEL_H
+#define QUESTIONLISTMODEL_H
+
+#include <QAbstractListModel>
+
+class QuestionManager;
+
+/**
+ * @brief 练习界面题目列表的模型
+ *
+ * 不保存每一行的数据，显示时直接从QuestionManager读取答题状态。
+ * 切换题目或提交答案时只通知状态变化的行，题目数量很多时翻题的开销也不变。
+ */
+class QuestionListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        QuestionIndexRole = Qt::UserRole    // 题目序号（从0开始）
+    };
+
+    explicit QuestionListModel(QObject *parent = nullptr);
+
+    /**
+     * @brief 重新关联题目数据（开始新练习或题目数量变化时调用）
+     * @param questionManager 题目管理器，为空时列表为空
+     * @param currentIndex 当前题目序号
+     */
+    void reset(const QuestionManager *questionManager, int currentIndex);
+
+    /**
+     * @brief 切换当前题目，只刷新原来和新的当前行
+     */
+    void setCurrentIndex(int index);
+    int currentIndex() const { return m_currentIndex; }
+
+    /**
+     * @brief 题目的答题状态变化后刷新对应的行
+     */
+    void refreshQuestion(int index);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+private:
+    void emitRowChanged(int row);
+
+    const QuestionManager *m_questionManager;
+    int m_rowCount;
+    int m_currentIndex;
+};
+
+#endif // QUESTIONLISTMODEL_H
@@ -0,0 +1,592 @@
+#include "legacymarkdownconverter.h"
+#include "../../utils/markdowntokenizer.h"
+#include <QRegularExpression>
+#include <QStack>
+#include <QUrl>
+
+LegacyMarkdownConverter::LegacyMarkdownConverter(const QMap<QString, QString> &images, const QString &imageBaseDir)
+    : m_images(images)
+    , m_imageBaseDir(imageBaseDir)
+{
+}
+
+// 原有的多遍正则转换流程
+QString LegacyMarkdownConverter::toHtml(const QString &markdown)
+{
+    // 所有正则只在第一次调用时编译
+    static const QRegularExpression blankLinesRegex("\n\\s*\n\\s*\n+");
+    static const QRegularExpression h6Regex("^###### (.+)$", QRegularExpression::MultilineOption);
+    static const QRegularExpression h5Regex("^##### (.+)$", QRegularExpression::MultilineOption);
+    static const QRegularExpression h4Regex("^#### (.+)$", QRegularExpression::MultilineOption);
+    static const QRegularExpression h3Regex("^### (.+)$", QRegularExpression::MultilineOption);
+    static const QRegularExpression h2Regex("^## (.+)$", QRegularExpression::MultilineOption);
+    static const QRegularExpression h1Regex("^# (.+)$", QRegularExpression::MultilineOption);
+    static const QRegularExpression boldItalicRegex("\\*\\*\\*(.+?)\\*\\*\\*");
+    static const QRegularExpression boldRegex("\\*\\*(.+?)\\*\\*");
+    static const QRegularExpression italicRegex("\\*(.+?)\\*");
+    static const QRegularExpression strikeRegex("~~(.+?)~~");
+    static const QRegularExpression inlineCodeRegex("`(.+?)`");
+    static const QRegularExpression linkRegex("(?<!\\!)\\[([^\\]]+)\\]\\(([^\\)]+)\\)");
+    static const QRegularExpression dashRuleRegex("^---+$", QRegularExpression::MultilineOption);
+    static const QRegularExpression starRuleRegex("^\\*\\*\\*+$", QRegularExpression::MultilineOption);
+    
+    QString html = markdown;
+    
+    // 使用统一的保护机制处理所有需要避免HTML转义的内容
+    html = protectSpecialContent(html);
+    
+    // HTML特殊字符转义（在保护特殊内容之后进行）
+    html = escapeHtmlSpecialChars(html);
+        
+    // 处理多行空行：将多个连续空行合并为一个
+    html.replace(blankLinesRegex, "\n\n");
+    
+    // 标题 (支持1-6级标题)
+    html.replace(h6Regex, "<h6>\\1</h6>");
+    html.replace(h5Regex, "<h5>\\1</h5>");
+    html.replace(h4Regex, "<h4>\\1</h4>");
+    html.replace(h3Regex, "<h3>\\1</h3>");
+    html.replace(h2Regex, "<h2>\\1</h2>");
+    html.replace(h1Regex, "<h1>\\1</h1>");
+    
+    // 粗斜体 (必须在粗体和斜体之前处理)
+    html.replace(boldItalicRegex, "<strong><em>\\1</em></strong>");
+    // html.replace(QRegularExpression("___(.+?)___"), "<strong><em>\\1</em></strong>");
+    
+    // 粗体
+    html.replace(boldRegex, "<strong>\\1</strong>");
+    // html.replace(QRegularExpression("__(.+?)__"), "<strong>\\1</strong>");
+    
+    html.replace(italicRegex, "<em>\\1</em>");
+    // html.replace(QRegularExpression("_(.+?)_"), "<em>\\1</em>");
+    
+    // 删除线
+    html.replace(strikeRegex, "<del>\\1</del>");
+    
+    // 行内代码
+    html.replace(inlineCodeRegex, "<code>\\1</code>");
+    
+    // 图片 ![alt](src)
+    {
+        static const QRegularExpression imageRegex("!\\[([^\\]]*)\\]\\(([^\\)]+)\\)");
+        QList<QRegularExpressionMatch> matches;
+        QRegularExpressionMatchIterator it = imageRegex.globalMatch(html);
+        while (it.hasNext()) {
+            matches.append(it.next());
+        }
+        for (int i = matches.size() - 1; i >= 0; --i) {
+            const QRegularExpressionMatch match = matches[i];
+            const QString altText = match.captured(1);
+            const QString rawSrc = match.captured(2).trimmed();
+            const QUrl finalUrl = MarkdownTokenizer::resolveImageUrl(rawSrc, m_images, m_imageBaseDir);
+
+            const QString imgTag = QString("<img src=\"%1\" alt=\"%2\" />")
+                .arg(finalUrl.toString().toHtmlEscaped(), altText);
+
+            html.replace(match.capturedStart(), match.capturedLength(), imgTag);
+        }
+    }
+
+    // 链接 [text](url)
+    html.replace(linkRegex, "<a href=\"\\2\">\\1</a>");
+    
+    // 水平分割线
+    html.replace(dashRuleRegex, "<hr>");
+    html.replace(starRuleRegex, "<hr>");
+    
+    // 处理列表
+    html = processLists(html);
+    
+    // 处理表格
+    html = processTables(html);
+    
+    // 段落处理
+    html = processParagraphs(html);
+
+    // 最后恢复并处理被保护的内容，避免代码块/行内代码被二次渲染
+    html = restoreAndProcessProtectedContent(html);
+    
+    return html;
+}
+
+QString LegacyMarkdownConverter::processCodeBlocks(const QString &html)
+{
+    QString result = html;
+    static const QRegularExpression codeBlockRegex("```([^\\r\\n]*)\\R?([\\s\\S]*?)```",
+                                      QRegularExpression::DotMatchesEverythingOption);
+    static const QRegularExpression languageRegex("^[A-Za-z][A-Za-z0-9_+\\-]{0,19}$");
+    
+    // 从后往前替换，避免位置偏移问题
+    QList<QRegularExpressionMatch> matches;
+    QRegularExpressionMatchIterator iterator = codeBlockRegex.globalMatch(result);
+    while (iterator.hasNext()) {
+        matches.append(iterator.next());
+    }
+    
+    for (int i = matches.size() - 1; i >= 0; --i) {
+        QRegularExpressionMatch match = matches[i];
+        const QString fenceInfo = match.captured(1);
+        const QString body = match.captured(2);
+
+        QString language;
+        QString code;
+
+        const QString trimmedFenceInfo = fenceInfo.trimmed();
+        if (!trimmedFenceInfo.isEmpty() && languageRegex.match(trimmedFenceInfo).hasMatch()) {
+            language = trimmedFenceInfo;
+            code = body;
+        } else {
+            language.clear();
+            code = fenceInfo;
+            if (code.startsWith(' ')) {
+                code = code.mid(1);
+            }
+            if (!body.isEmpty()) {
+                if (!code.isEmpty()) {
+                    code += "\n";
+                }
+                code += body;
+            }
+        }
+
+        code.replace("\r\n", "\n");
+        code.replace("\r", "\n");
+        if (code.endsWith('\n')) {
+            code.chop(1);
+        }
+
+        const QString escapedCode = code.toHtmlEscaped();
+        QString codeBlock;
+        if (!language.isEmpty()) {
+            codeBlock = QString("<pre><code class=\"language-%1\">%2</code></pre>")
+                       .arg(language, escapedCode);
+        } else {
+            codeBlock = QString("<pre><code>%1</code></pre>").arg(escapedCode);
+        }
+        
+        result.replace(match.capturedStart(), match.capturedLength(), codeBlock);
+    }
+    
+    return result;
+}
+
+QString LegacyMarkdownConverter::processLatexBlocks(const QString &html)
+{
+    QString result = html;
+    
+    // 先处理双美元符号的LaTeX公式
+    static const QRegularExpression latexBlockRegex("\\$\\$([^$]*?)\\$\\$", QRegularExpression::DotMatchesEverythingOption);
+    QList<QRegularExpressionMatch> blockMatches;
+    QRegularExpressionMatchIterator blockIterator = latexBlockRegex.globalMatch(result);
+    while (blockIterator.hasNext()) {
+        blockMatches.append(blockIterator.next());
+    }
+    
+    // 从后往前替换，避免位置偏移问题
+    for (int i = blockMatches.size() - 1; i >= 0; --i) {
+        QRegularExpressionMatch match = blockMatches[i];
+        QString latexContent = match.captured(1).trimmed();
+        QString latexBlock = QString("$$%1$$").arg(latexContent);
+        result.replace(match.capturedStart(), match.capturedLength(), latexBlock);
+    }
+    
+    // 再处理单美元符号的LaTeX公式
+    static const QRegularExpression singleLatexRegex("\\$([^$\\n]*?)\\$");
+    QList<QRegularExpressionMatch> singleMatches;
+    QRegularExpressionMatchIterator singleIterator = singleLatexRegex.globalMatch(result);
+    while (singleIterator.hasNext()) {
+        singleMatches.append(singleIterator.next());
+    }
+    
+    // 从后往前替换，避免位置偏移问题
+    for (int i = singleMatches.size() - 1; i >= 0; --i) {
+        QRegularExpressionMatch match = singleMatches[i];
+        QString latexContent = match.captured(1);
+        QString latexBlock = QString("$%1$").arg(latexContent);
+        result.replace(match.capturedStart(), match.capturedLength(), latexBlock);
+    }
+    
+    return result;
+}
+
+QString LegacyMarkdownConverter::escapeHtmlSpecialChars(const QString &html)
+{
+    QString result = html;
+    
+    // 转义HTML特殊字符
+    result.replace("&", "&amp;");  // 必须首先处理&，避免重复转义
+    result.replace("<", "&lt;");
+    result.replace(">", "&gt;");
+    result.replace('"', "&quot;");
+    
+    return result;
+}
+
+QString LegacyMarkdownConverter::processParagraphs(const QString &html)
+{
+    const QStringList lines = html.split('\n');
+    QStringList outputLines;
+    QStringList paragraphLines;
+
+    auto flushParagraph = [&]() {
+        if (paragraphLines.isEmpty()) {
+            return;
+        }
+        outputLines.append("<p>" + paragraphLines.join(" ") + "</p>");
+        paragraphLines.clear();
+    };
+
+    for (const QString &rawLine : lines) {
+        const QString line = rawLine.trimmed();
+
+        if (line.isEmpty()) {
+            flushParagraph();
+            continue;
+        }
+
+        const bool isProtected = line.startsWith("__PROTECTED_");
+        const bool isBlockTag =
+            line.startsWith("<h") ||
+            line.startsWith("<ul") ||
+            line.startsWith("<ol") ||
+            line.startsWith("<li") ||
+            line.startsWith("<blockquote") ||
+            line.startsWith("<pre") ||
+            line.startsWith("<table") ||
+            line.startsWith("<tr") ||
+            line.startsWith("<th") ||
+            line.startsWith("<td") ||
+            line.startsWith("<hr") ||
+            line.startsWith("</");
+
+        if (isProtected || isBlockTag) {
+            flushParagraph();
+            outputLines.append(line);
+            continue;
+        }
+
+        paragraphLines.append(line);
+    }
+
+    flushParagraph();
+
+    return outputLines.join('\n');
+}
+
+QString LegacyMarkdownConverter::processLists(const QString &html)
+{
+    QString result = html;
+    
+    // 处理列表（支持嵌套）
+    QStringList lines = result.split('\n');
+    QStringList processedLines;
+    QStack<QString> listStack; // 存储当前嵌套的列表类型
+    QStack<int> indentStack;   // 存储当前嵌套的缩进级别
+    QStack<int> olStartStack;  // 存储有序列表的起始编号
+    
+    for (const QString &line : lines) {
+        QString trimmedLine = line.trimmed();
+        
+        // 检查是否是列表项
+        static const QRegularExpression ulRegex("^[*+-]\\s+(.+)$");
+        static const QRegularExpression olRegex("^(\\d+)\\.\\s+(.+)$");
+        QRegularExpressionMatch ulMatch = ulRegex.match(trimmedLine);
+        QRegularExpressionMatch olMatch = olRegex.match(trimmedLine);
+        
+        if (ulMatch.hasMatch() || olMatch.hasMatch()) {
+            // 计算当前行的缩进级别
+            int currentIndent = line.length() - line.trimmed().length();
+            QString listType = ulMatch.hasMatch() ? "ul" : "ol";
+            QString content = ulMatch.hasMatch() ? ulMatch.captured(1) : olMatch.captured(2);
+            int olNumber = olMatch.hasMatch() ? olMatch.captured(1).toInt() : 1;
+            
+            // 处理嵌套逻辑
+            while (!indentStack.isEmpty() && currentIndent <= indentStack.top()) {
+                QString closingTag = "</" + listStack.pop() + ">";
+                processedLines.append(closingTag);
+                indentStack.pop();
+                if (!olStartStack.isEmpty()) {
+                    olStartStack.pop();
+                }
+            }
+            
+            // 如果是新的嵌套级别或不同类型的列表
+            if (indentStack.isEmpty() || currentIndent > indentStack.top() || 
+                (!listStack.isEmpty() && listStack.top() != listType)) {
+                if (!indentStack.isEmpty() && listStack.top() != listType) {
+                    // 关闭当前列表，开始新类型的列表
+                    QString closingTag = "</" + listStack.pop() + ">";
+                    processedLines.append(closingTag);
+                    indentStack.pop();
+                    if (!olStartStack.isEmpty()) {
+                        olStartStack.pop();
+                    }
+                }
+                
+                QString openingTag;
+                if (listType == "ol") {
+                    // 对于有序列表，添加start属性
+                    openingTag = QString("<ol start=\"%1\">").arg(olNumber);
+                    olStartStack.push(olNumber);
+                } else {
+                    openingTag = "<ul>";
+                }
+                processedLines.append(openingTag);
+                listStack.push(listType);
+                indentStack.push(currentIndent);
+            }
+            
+            processedLines.append("<li>" + content + "</li>");
+        } else {
+            // 非列表行，关闭所有打开的列表
+            while (!listStack.isEmpty()) {
+                QString closingTag = "</" + listStack.pop() + ">";
+                processedLines.append(closingTag);
+                indentStack.pop();
+                if (!olStartStack.isEmpty()) {
+                    olStartStack.pop();
+                }
+            }
+
+            processedLines.append(line);
+        }
+    }
+    
+    // 关闭剩余的列表
+    while (!listStack.isEmpty()) {
+        QString closingTag = "</" + listStack.pop() + ">";
+        processedLines.append(closingTag);
+        indentStack.pop();
+        if (!olStartStack.isEmpty()) {
+            olStartStack.pop();
+        }
+    }
+    
+    return processedLines.join('\n');
+}
+
+QString LegacyMarkdownConverter::processTables(const QString &html)
+{
+    QString result = html;
+    static const QRegularExpression tableRegex("(^\\|.+\\|$\n)+", QRegularExpression::MultilineOption);
+    QRegularExpressionMatchIterator tableIterator = tableRegex.globalMatch(result);
+    QStringList tableMatches;
+    
+    while (tableIterator.hasNext()) {
+        QRegularExpressionMatch match = tableIterator.next();
+        QString matchedText = match.captured(0);
+        QString placeholder = QString("__TABLE_%1__").arg(tableMatches.size());
+        tableMatches.append(matchedText);
+        result.replace(matchedText, placeholder);
+    }
+    
+    for (int i = 0; i < tableMatches.size(); ++i) {
+        QString tableText = tableMatches[i];
+        QStringList rows = tableText.split('\n', Qt::SkipEmptyParts);
+        
+        if (rows.size() < 2) {
+            // 不是有效的表格，至少需要标题行和分隔行
+            result.replace(QString("__TABLE_%1__").arg(i), tableText);
+            continue;
+        }
+        
+        // 检查是否有分隔行（第二行）
+        static const QRegularExpression separatorRegex("^\\|\\s*(:?-+:?\\s*\\|)+\\s*$");
+        if (!separatorRegex.match(rows[1]).hasMatch()) {
+            // 不是有效的表格分隔行
+            result.replace(QString("__TABLE_%1__").arg(i), tableText);
+            continue;
+        }
+        
+        QString htmlTable = "<table>\n";
+        
+        // 处理表头
+        htmlTable += "<thead>\n<tr>\n";
+        QStringList headerCells = rows[0].split('|');
+        // 移除首尾空单元格（如果存在）
+        if (!headerCells.isEmpty() && headerCells.first().trimmed().isEmpty()) {
+            headerCells.removeFirst();
+        }
+        if (!headerCells.isEmpty() && headerCells.last().trimmed().isEmpty()) {
+            headerCells.removeLast();
+        }
+        
+        for (const QString &cell : headerCells) {
+            htmlTable += "<th>" + cell.trimmed() + "</th>\n";
+        }
+        
+        htmlTable += "</tr>\n</thead>\n";
+        
+        // 处理表格内容
+        if (rows.size() > 2) {
+            htmlTable += "<tbody>\n";
+            
+            for (int j = 2; j < rows.size(); ++j) {
+                htmlTable += "<tr>\n";
+                QStringList cells = rows[j].split('|');
+                
+                // 移除首尾空单元格（如果存在）
+                if (!cells.isEmpty() && cells.first().trimmed().isEmpty()) {
+                    cells.removeFirst();
+                }
+                if (!cells.isEmpty() && cells.last().trimmed().isEmpty()) {
+                    cells.removeLast();
+                }
+                
+                for (const QString &cell : cells) {
+                    htmlTable += "<td>" + cell.trimmed() + "</td>\n";
+                }
+                
+                htmlTable += "</tr>\n";
+            }
+            
+            htmlTable += "</tbody>\n";
+        }
+        
+        htmlTable += "</table>";
+        result.replace(QString("__TABLE_%1__").arg(i), htmlTable);
+    }
+    
+    return result;
+}
+
+QString LegacyMarkdownConverter::protectSpecialContent(const QString &html)
+{
+    QString result = html;
+    
+    // 存储需要保护的内容
+    QStringList protectedBlocks;
+    QStringList placeholders;
+    
+    // 保护代码块 - 使用原始markdown语法
+    static const QRegularExpression codeBlockRegex("```[^\\r\\n]*\\R?[\\s\\S]*?```", QRegularExpression::DotMatchesEverythingOption);
+    QRegularExpressionMatchIterator codeIterator = codeBlockRegex.globalMatch(result);
+    QList<QRegularExpressionMatch> codeMatches;
+    while (codeIterator.hasNext()) {
+        codeMatches.append(codeIterator.next());
+    }
+    // 从后往前替换，避免位置偏移
+    for (int i = codeMatches.size() - 1; i >= 0; --i) {
+        QRegularExpressionMatch match = codeMatches[i];
+        QString placeholder = QString("__PROTECTED_CODE_%1__").arg(protectedBlocks.size());
+        protectedBlocks.append(match.captured(0));
+        placeholders.append(placeholder);
+        result.replace(match.capturedStart(), match.capturedLength(), placeholder);
+    }
+    
+    // 保护行内代码
+    static const QRegularExpression inlineCodeRegex("`([^`]+)`");
+    QRegularExpressionMatchIterator inlineCodeIterator = inlineCodeRegex.globalMatch(result);
+    QList<QRegularExpressionMatch> inlineCodeMatches;
+    while (inlineCodeIterator.hasNext()) {
+        inlineCodeMatches.append(inlineCodeIterator.next());
+    }
+    // 从后往前替换，避免位置偏移
+    for (int i = inlineCodeMatches.size() - 1; i >= 0; --i) {
+        QRegularExpressionMatch match = inlineCodeMatches[i];
+        QString placeholder = QString("__PROTECTED_INLINE_CODE_%1__").arg(protectedBlocks.size());
+        protectedBlocks.append(match.captured(0));
+        placeholders.append(placeholder);
+        result.replace(match.capturedStart(), match.capturedLength(), placeholder);
+    }
+    
+    // 保护双美元符号LaTeX公式
+    static const QRegularExpression latexBlockRegex("\\$\\$([^$]*?)\\$\\$", QRegularExpression::DotMatchesEverythingOption);
+    QRegularExpressionMatchIterator latexBlockIterator = latexBlockRegex.globalMatch(result);
+    QList<QRegularExpressionMatch> latexBlockMatches;
+    while (latexBlockIterator.hasNext()) {
+        latexBlockMatches.append(latexBlockIterator.next());
+    }
+    // 从后往前替换，避免位置偏移
+    for (int i = latexBlockMatches.size() - 1; i >= 0; --i) {
+        QRegularExpressionMatch match = latexBlockMatches[i];
+        // 获取原始内容并进行特殊处理
+        QString latexContent = match.captured(0);
+        // 使用HTML实体编码替换<和>，确保它们在LaTeX处理时被正确解释
+        latexContent.replace("<", "&lt;");
+        latexContent.replace(">", "&gt;");
+        QString placeholder = QString("__PROTECTED_LATEX_BLOCK_%1__").arg(protectedBlocks.size());
+        protectedBlocks.append(latexContent);
+        placeholders.append(placeholder);
+        result.replace(match.capturedStart(), match.capturedLength(), placeholder);
+    }
+    
+    // 保护单美元符号LaTeX公式
+    static const QRegularExpression latexInlineRegex("\\$([^$]+?)\\$");
+    QRegularExpressionMatchIterator latexInlineIterator = latexInlineRegex.globalMatch(result);
+    QList<QRegularExpressionMatch> latexInlineMatches;
+    while (latexInlineIterator.hasNext()) {
+        latexInlineMatches.append(latexInlineIterator.next());
+    }
+    // 从后往前替换，避免位置偏移
+    for (int i = latexInlineMatches.size() - 1; i >= 0; --i) {
+        QRegularExpressionMatch match = latexInlineMatches[i];
+        // 获取原始内容并进行特殊处理
+        QString latexContent = match.captured(0);
+        // 使用HTML实体编码替换<和>，确保它们在LaTeX处理时被正确解释
+        latexContent.replace("<", "&lt;");
+        latexContent.replace(">", "&gt;");
+        QString placeholder = QString("__PROTECTED_LATEX_INLINE_%1__").arg(protectedBlocks.size());
+        protectedBlocks.append(latexContent);
+        placeholders.append(placeholder);
+        result.replace(match.capturedStart(), match.capturedLength(), placeholder);
+    }
+    
+    // 保护引用块
+    static const QRegularExpression quoteRegex("^> (.+)$", QRegularExpression::MultilineOption);
+    QRegularExpressionMatchIterator quoteIterator = quoteRegex.globalMatch(result);
+    QList<QRegularExpressionMatch> quoteMatches;
+    while (quoteIterator.hasNext()) {
+        quoteMatches.append(quoteIterator.next());
+    }
+    // 从后往前替换，避免位置偏移
+    for (int i = quoteMatches.size() - 1; i >= 0; --i) {
+        QRegularExpressionMatch match = quoteMatches[i];
+        QString placeholder = QString("__PROTECTED_QUOTE_%1__").arg(protectedBlocks.size());
+        protectedBlocks.append(match.captured(0));
+        placeholders.append(placeholder);
+        result.replace(match.capturedStart(), match.capturedLength(), placeholder);
+    }
+    
+    // 将保护信息存储到成员变量中，供后续恢复使用
+    m_protectedBlocks = protectedBlocks;
+    m_placeholders = placeholders;
+    
+    return result;
+}
+
+QString LegacyMarkdownConverter::restoreAndProcessProtectedContent(const QString &html)
+{
+    QString result = html;
+    
+    // 恢复并处理被保护的内容
+    for (int i = 0; i < m_protectedBlocks.size(); ++i) {
+        QString content = m_protectedBlocks[i];
+        QString placeholder = m_placeholders[i];
+        
+        if (placeholder.startsWith("__PROTECTED_CODE_")) {
+            // 处理代码块
+            content = processCodeBlocks(content);
+        } else if (placeholder.startsWith("__PROTECTED_INLINE_CODE_")) {
+            // 处理行内代码
+            static const QRegularExpression inlineCodeRegex("`([^`]+)`");
+            content.replace(inlineCodeRegex, "<code>\\1</code>");
+        } else if (placeholder.startsWith("__PROTECTED_LATEX_BLOCK_")) {
+            // 处理LaTeX块公式 - 直接使用原始内容，不需要额外处理
+        } else if (placeholder.startsWith("__PROTECTED_LATEX_INLINE_")) {
+            // 处理LaTeX行内公式 - 直接使用原始内容，不需要额外处理
+        } else if (placeholder.startsWith("__PROTECTED_QUOTE_")) {
+            // 处理引用块
+            static const QRegularExpression quoteRegex("^> (.+)$", QRegularExpression::MultilineOption);
+            content.replace(quoteRegex, "<blockquote>\\1</blockquote>");
+        }
+        
+        result.replace(placeholder, content);
+    }
+    
+    // 清理保护信息
+    m_protectedBlocks.clear();
+    m_placeholders.clear();
+    
+    return result;
+}
@@ -0,0 +1,39 @@
+#ifndef LEGACYMARKDOWNCONVERTER_H
+#define LEGACYMARKDOWNCONVERTER_H
+
+#include <QString>
+#include <QStringList>
+#include <QMap>
+
+/**
+ * @brief MarkdownRenderer原有的多遍正则转换器
+ *
+ * 程序已改用MarkdownTokenizer，这里只保留原实现供基准测试对比输出和耗时。
+ */
+class LegacyMarkdownConverter
+{
+public:
+    LegacyMarkdownConverter(const QMap<QString, QString> &images = QMap<QString, QString>(),
+                            const QString &imageBaseDir = QString());
+
+    QString toHtml(const QString &markdown);
+
+private:
+    QString protectSpecialContent(const QString &html);
+    QString restoreAndProcessProtectedContent(const QString &html);
+    QString processCodeBlocks(const QString &html);
+    QString processLatexBlocks(const QString &html);
+    QString escapeHtmlSpecialChars(const QString &html);
+    QString processParagraphs(const QString &html);
+    QString processLists(const QString &html);
+    QString processTables(const QString &html);
+
+    QMap<QString, QString> m_images;
+    QString m_imageBaseDir;
+
+    // 用于保护特殊内容的成员变量
+    QStringList m_protectedBlocks;
+    QStringList m_placeholders;
+};
+
+#endif // LEGACYMARKDOWNCONVERTER_H
@@ -0,0 +1,127 @@
+#include "legacymarkdownconverter.h"
+#include "../../utils/markdowntokenizer.h"
+#include "../../utils/bankscanner.h"
+#include "../../models/questionbank.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QTextStream>
+
+// 比较时忽略标签之间和连续的空白，两种转换器的换行方式不同
+static QString normalizeHtmlForComparison(const QString &html)
+{
+    static const QRegularExpression betweenTagsRegex(">\\s+<");
+    QString normalized = html.simplified();
+    normalized.replace(betweenTagsRegex, "><");
+    return normalized;
+}
+
+// 用科目目录中所有题库的题干和选项作为样本
+static QStringList loadSamples(const QStringList &subjectDirs)
+{
+    QStringList samples;
+    for (const QString &subjectDir : subjectDirs) {
+        const QString subjectName = QFileInfo(subjectDir).fileName();
+        const QuestionBank questionBank = BankScanner::scanSubjectDirectory(subjectDir, subjectName);
+        for (const QuestionBankInfo &bank : questionBank.getAllBanks()) {
+            const QList<Question> questions = questionBank.loadAllQuestionsFromBank(subjectDir, bank);
+            for (const Question &question : questions) {
+                samples.append(question.getQuestion());
+                for (const QString &choice : question.getChoices()) {
+                    samples.append(choice);
+                }
+            }
+        }
+    }
+    return samples;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("markdownbench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("比较原有的正则Markdown转换器和MarkdownTokenizer的耗时与输出");
+    parser.addHelpOption();
+    QCommandLineOption roundsOption(QStringList() << "r" << "rounds", "每个转换器重复转换全部样本的轮数（默认5）", "rounds", "5");
+    parser.addOption(roundsOption);
+    parser.addPositionalArgument("subjects", "科目目录，默认使用Subject下的所有科目", "[subjects...]");
+    parser.process(app);
+
+    QTextStream out(stdout);
+
+    QStringList subjectDirs = parser.positionalArguments();
+    if (subjectDirs.isEmpty()) {
+        const QDir subjectRoot("Subject");
+        for (const QString &name : subjectRoot.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name)) {
+            subjectDirs.append(subjectRoot.filePath(name));
+        }
+    }
+
+    const QStringList samples = loadSamples(subjectDirs);
+    if (samples.isEmpty()) {
+        out << "No questions found, nothing to benchmark" << Qt::endl;
+        return 1;
+    }
+
+    bool ok = false;
+    int rounds = parser.value(roundsOption).toInt(&ok);
+    if (!ok || rounds <= 0) {
+        rounds = 5;
+    }
+
+    // 对比只关心转换本身，不使用图片映射
+    LegacyMarkdownConverter legacy;
+    QStringList legacyResults;
+    QStringList tokenizerResults;
+    legacyResults.reserve(samples.size());
+    tokenizerResults.reserve(samples.size());
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int round = 0; round < rounds; ++round) {
+        for (const QString &sample : samples) {
+            const QString html = legacy.toHtml(sample);
+            if (round == 0) {
+                legacyResults.append(html);
+            }
+        }
+    }
+    const qint64 legacyNs = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int round = 0; round < rounds; ++round) {
+        for (const QString &sample : samples) {
+            const QString html = MarkdownTokenizer::toHtml(sample);
+            if (round == 0) {
+                tokenizerResults.append(html);
+            }
+        }
+    }
+    const qint64 tokenizerNs = timer.nsecsElapsed();
+
+    int mismatches = 0;
+    for (int i = 0; i < samples.size(); ++i) {
+        if (normalizeHtmlForComparison(legacyResults[i]) != normalizeHtmlForComparison(tokenizerResults[i])) {
+            if (mismatches < 5) {
+                out << "Output differs for sample " << i << ": " << samples[i].left(200) << Qt::endl;
+                out << "  legacy:    " << legacyResults[i].left(400) << Qt::endl;
+                out << "  tokenizer: " << tokenizerResults[i].left(400) << Qt::endl;
+            }
+            ++mismatches;
+        }
+    }
+
+    const double runs = double(samples.size()) * rounds;
+    out << "Markdown converter benchmark: " << samples.size() << " samples x " << rounds << " rounds" << Qt::endl;
+    out << "  legacy:    " << legacyNs / 1000000.0 << " ms, " << legacyNs / runs / 1000.0 << " us/sample" << Qt::endl;
+    out << "  tokenizer: " << tokenizerNs / 1000000.0 << " ms, " << tokenizerNs / runs / 1000.0 << " us/sample" << Qt::endl;
+    out << "  speedup:   " << (tokenizerNs > 0 ? double(legacyNs) / tokenizerNs : 0.0)
+        << "x, differing outputs: " << mismatches << Qt::endl;
+
+    return 0;
+}
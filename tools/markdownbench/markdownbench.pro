@@ -0,0 +1,30 @@
+# Markdown转换器基准测试：比较原有的正则转换器和MarkdownTokenizer
+# 用法：markdownbench [-r 轮数] [科目目录...]，默认使用当前目录Subject下的所有科目
+
+QT       += core gui webenginewidgets concurrent
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = markdownbench
+
+SOURCES += \
+    main.cpp \
+    legacymarkdownconverter.cpp \
+    ../../models/question.cpp \
+    ../../models/questionbank.cpp \
+    ../../utils/bankscanner.cpp \
+    ../../utils/markdowntokenizer.cpp \
+    ../../utils/mathprerenderer.cpp \
+    ../../utils/resourceschemehandler.cpp \
+    ../../utils/textnormalize.cpp
+
+HEADERS += \
+    legacymarkdownconverter.h \
+    ../../models/question.h \
+    ../../models/questionbank.h \
+    ../../utils/bankscanner.h \
+    ../../utils/markdowntokenizer.h \
+    ../../utils/mathprerenderer.h \
+    ../../utils/resourceschemehandler.h \
+    ../../utils/textnormalize.h
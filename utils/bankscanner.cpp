@@ -7,6 +7,8 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QDebug>
+#include <QtConcurrent/QtConcurrentMap>
+#include <algorithm>
 
 // 初始化静态成员变量
 QString BankScanner::s_lastError;
@@ -104,99 +106,200 @@ static QMap<QuestionType, int> countQuestionsByType(const QJsonDocument &doc)
     return counts;
 }
 
-QuestionBank BankScanner::scanSubjectDirectory(const QString &dirPath, const QString &subjectName)
+struct SubjectScanTask {
+    QString subjectName;
+    QString dirPath;
+};
+
+struct FileScanTask {
+    QString dirPath;
+    QString filePath;
+};
+
+struct FileScanResult {
+    QVector<QuestionBankInfo> banks;
+    QString error;
+};
+
+static QStringList listSubjectBankFiles(const SubjectScanTask &task)
 {
-    s_lastError.clear();
-    QuestionBank bank(subjectName);
-    QDir dir(dirPath);
-    
-    if (!dir.exists()) {
-        s_lastError = QString("科目目录不存在: %1").arg(dirPath);
-        qWarning() << s_lastError;
-        return bank;
+    return BankScanner::listBankFiles(task.dirPath);
+}
+
+static FileScanResult scanFileTask(const FileScanTask &task)
+{
+    FileScanResult result;
+    result.banks = BankScanner::scanBankFile(task.dirPath, task.filePath, &result.error);
+    return result;
+}
+
+static void addBanksTo(QuestionBank &bank, const QVector<QuestionBankInfo> &banks)
+{
+    for (const QuestionBankInfo &info : banks) {
+        if (info.type == QuestionType::Choice) {
+            bank.addChoiceBank(info);
+        } else if (info.type == QuestionType::TrueOrFalse) {
+            bank.addTrueOrFalseBank(info);
+        } else if (info.type == QuestionType::FillBlank) {
+            bank.addFillBlankBank(info);
+        }
+    }
+}
+
+QStringList BankScanner::listBankFiles(const QString &dirPath)
+{
+    QStringList files;
+    if (!QDir(dirPath).exists()) {
+        return files;
     }
 
-    QString firstError;
     QDirIterator it(dirPath, QStringList() << "*.json", QDir::Files, QDirIterator::Subdirectories);
     while (it.hasNext()) {
-        QString filePath = it.next();
+        files.append(it.next());
+    }
 
-        QJsonDocument doc;
-        QString error;
-        if (!readAndValidateBankFile(filePath, &doc, &error)) {
-            if (firstError.isEmpty()) {
-                firstError = error;
-            }
-            continue;
+    // 文件系统返回的顺序不稳定，排序后保证题库列表顺序在多次扫描间一致
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+QVector<QuestionBankInfo> BankScanner::scanBankFile(const QString &dirPath, const QString &filePath, QString *errorOut)
+{
+    QVector<QuestionBankInfo> banks;
+
+    QJsonDocument doc;
+    if (!readAndValidateBankFile(filePath, &doc, errorOut)) {
+        return banks;
+    }
+
+    QMap<QuestionType, int> counts = countQuestionsByType(doc);
+    QMap<QuestionType, int> supportedCounts;
+    supportedCounts[QuestionType::Choice] = counts.value(QuestionType::Choice, 0);
+    supportedCounts[QuestionType::TrueOrFalse] = counts.value(QuestionType::TrueOrFalse, 0);
+    supportedCounts[QuestionType::FillBlank] = counts.value(QuestionType::FillBlank, 0);
+
+    int supportedTypesInFile = 0;
+    for (auto itCount = supportedCounts.constBegin(); itCount != supportedCounts.constEnd(); ++itCount) {
+        if (itCount.value() > 0) {
+            supportedTypesInFile++;
         }
+    }
+    if (supportedTypesInFile == 0) {
+        return banks;
+    }
 
-        QMap<QuestionType, int> counts = countQuestionsByType(doc);
-        QMap<QuestionType, int> supportedCounts;
-        supportedCounts[QuestionType::Choice] = counts.value(QuestionType::Choice, 0);
-        supportedCounts[QuestionType::TrueOrFalse] = counts.value(QuestionType::TrueOrFalse, 0);
-        supportedCounts[QuestionType::FillBlank] = counts.value(QuestionType::FillBlank, 0);
+    QString relPath = QDir(dirPath).relativeFilePath(filePath);
+    relPath = QDir::fromNativeSeparators(relPath);
+    QString baseDisplayName = QFileInfo(relPath).completeBaseName();
 
-        int supportedTypesInFile = 0;
-        for (auto itCount = supportedCounts.constBegin(); itCount != supportedCounts.constEnd(); ++itCount) {
-            if (itCount.value() > 0) {
-                supportedTypesInFile++;
-            }
+    auto addBank = [&](QuestionType type, int count) {
+        if (count <= 0) {
+            return;
+        }
+        QuestionBankInfo bankInfo;
+        QString srcToStore = relPath;
+        QString typeFolder = questionTypeToString(type);
+        QString prefix = typeFolder + "/";
+        if (supportedTypesInFile == 1 && relPath.startsWith(prefix) && !relPath.mid(prefix.size()).contains('/')) {
+            srcToStore = relPath.mid(prefix.size());
+        }
+        bankInfo.src = srcToStore;
+        bankInfo.type = type;
+        bankInfo.chosen = false;
+        bankInfo.chosennum = 1;
+        bankInfo.size = count;
+
+        if (supportedTypesInFile > 1) {
+            bankInfo.name = QString("%1 (%2)").arg(baseDisplayName, questionTypeToString(type));
+        } else {
+            bankInfo.name = baseDisplayName;
         }
-        if (supportedTypesInFile == 0) {
+
+        banks.append(bankInfo);
+    };
+
+    addBank(QuestionType::Choice, supportedCounts.value(QuestionType::Choice, 0));
+    addBank(QuestionType::TrueOrFalse, supportedCounts.value(QuestionType::TrueOrFalse, 0));
+    addBank(QuestionType::FillBlank, supportedCounts.value(QuestionType::FillBlank, 0));
+
+    return banks;
+}
+
+QuestionBank BankScanner::scanSubjectDirectory(const QString &dirPath, const QString &subjectName)
+{
+    QMap<QString, QString> subjectPaths;
+    subjectPaths.insert(subjectName, dirPath);
+    return scanSubjectDirectories(subjectPaths).value(subjectName, QuestionBank(subjectName));
+}
+
+QMap<QString, QuestionBank> BankScanner::scanSubjectDirectories(const QMap<QString, QString> &subjectPaths)
+{
+    s_lastError.clear();
+    QMap<QString, QuestionBank> result;
+
+    // 第一阶段：并行遍历各科目目录，收集题库文件列表
+    QList<SubjectScanTask> subjectTasks;
+    for (auto it = subjectPaths.constBegin(); it != subjectPaths.constEnd(); ++it) {
+        if (!QDir(it.value()).exists()) {
+            s_lastError = QString("科目目录不存在: %1").arg(it.value());
+            qWarning() << s_lastError;
+            result.insert(it.key(), QuestionBank(it.key()));
             continue;
         }
+        SubjectScanTask task;
+        task.subjectName = it.key();
+        task.dirPath = it.value();
+        subjectTasks.append(task);
+    }
+    if (subjectTasks.isEmpty()) {
+        return result;
+    }
 
-        QString relPath = QDir(dirPath).relativeFilePath(filePath);
-        relPath = QDir::fromNativeSeparators(relPath);
-        QString baseDisplayName = QFileInfo(relPath).completeBaseName();
+    const QList<QStringList> filesPerSubject = QtConcurrent::blockingMapped(subjectTasks, listSubjectBankFiles);
 
-        auto addBank = [&](QuestionType type, int count) {
-            if (count <= 0) {
-                return;
-            }
-            QuestionBankInfo bankInfo;
-            QString srcToStore = relPath;
-            QString typeFolder = questionTypeToString(type);
-            QString prefix = typeFolder + "/";
-            if (supportedTypesInFile == 1 && relPath.startsWith(prefix) && !relPath.mid(prefix.size()).contains('/')) {
-                srcToStore = relPath.mid(prefix.size());
-            }
-            bankInfo.src = srcToStore;
-            bankInfo.type = type;
-            bankInfo.chosen = false;
-            bankInfo.chosennum = 1;
-            bankInfo.size = count;
-
-            if (supportedTypesInFile > 1) {
-                bankInfo.name = QString("%1 (%2)").arg(baseDisplayName, questionTypeToString(type));
-            } else {
-                bankInfo.name = baseDisplayName;
-            }
+    // 第二阶段：把所有科目的文件展平后并行读取、校验、统计题型
+    QList<FileScanTask> fileTasks;
+    QVector<int> subjectFileOffsets;
+    subjectFileOffsets.reserve(subjectTasks.size() + 1);
+    for (int i = 0; i < subjectTasks.size(); ++i) {
+        subjectFileOffsets.append(fileTasks.size());
+        for (const QString &filePath : filesPerSubject[i]) {
+            FileScanTask task;
+            task.dirPath = subjectTasks[i].dirPath;
+            task.filePath = filePath;
+            fileTasks.append(task);
+        }
+    }
+    subjectFileOffsets.append(fileTasks.size());
 
-            if (type == QuestionType::Choice) {
-                bank.addChoiceBank(bankInfo);
-            } else if (type == QuestionType::TrueOrFalse) {
-                bank.addTrueOrFalseBank(bankInfo);
-            } else if (type == QuestionType::FillBlank) {
-                bank.addFillBlankBank(bankInfo);
+    const QList<FileScanResult> fileResults = QtConcurrent::blockingMapped(fileTasks, scanFileTask);
+
+    // 按科目、文件的原始顺序合并结果，保证题库信息顺序稳定
+    for (int i = 0; i < subjectTasks.size(); ++i) {
+        const QString &subjectName = subjectTasks[i].subjectName;
+        QuestionBank bank(subjectName);
+        QString firstError;
+        for (int f = subjectFileOffsets[i]; f < subjectFileOffsets[i + 1]; ++f) {
+            const FileScanResult &fileResult = fileResults[f];
+            if (!fileResult.error.isEmpty() && firstError.isEmpty()) {
+                firstError = fileResult.error;
             }
-        };
-
-        addBank(QuestionType::Choice, supportedCounts.value(QuestionType::Choice, 0));
-        addBank(QuestionType::TrueOrFalse, supportedCounts.value(QuestionType::TrueOrFalse, 0));
-        addBank(QuestionType::FillBlank, supportedCounts.value(QuestionType::FillBlank, 0));
-    }
-    
-    // 检查是否找到了题库文件
-    int totalBanks = bank.getChoiceBanks().size() + bank.getTrueOrFalseBanks().size() + bank.getFillBlankBanks().size();
-    if (totalBanks == 0) {
-        s_lastError = firstError.isEmpty()
-            ? QString("在科目文件夹 '%1' 中未找到有效的题库文件").arg(subjectName)
-            : firstError;
-        qWarning() << s_lastError;
-    }
-    
-    return bank;
+            addBanksTo(bank, fileResult.banks);
+        }
+
+        // 检查是否找到了题库文件
+        int totalBanks = bank.getChoiceBanks().size() + bank.getTrueOrFalseBanks().size() + bank.getFillBlankBanks().size();
+        if (totalBanks == 0) {
+            s_lastError = firstError.isEmpty()
+                ? QString("在科目文件夹 '%1' 中未找到有效的题库文件").arg(subjectName)
+                : firstError;
+            qWarning() << s_lastError;
+        }
+
+        result.insert(subjectName, bank);
+    }
+
+    return result;
 }
 
 bool BankScanner::validateBankFile(const QString &filePath)
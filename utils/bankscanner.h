@@ -23,6 +23,34 @@ public:
      */
     static QuestionBank scanSubjectDirectory(const QString &dirPath, const QString &subjectName);
     
+    /**
+     * @brief 批量扫描多个科目目录
+     * 
+     * 目录遍历与题库文件的读取、校验、题型统计都在全局线程池中并行执行，
+     * 结果按科目名、文件路径排序后合并，保证题库信息顺序稳定
+     * @param subjectPaths 科目名称到科目目录路径的映射
+     * @return 科目名称到题库对象的映射
+     */
+    static QMap<QString, QuestionBank> scanSubjectDirectories(const QMap<QString, QString> &subjectPaths);
+    
+    /**
+     * @brief 列出科目目录下的所有题库文件（按路径排序）
+     * @param dirPath 科目目录路径
+     * @return 题库文件的完整路径列表
+     */
+    static QStringList listBankFiles(const QString &dirPath);
+    
+    /**
+     * @brief 扫描单个题库文件，生成其中各题型对应的题库信息
+     * 
+     * 不修改静态错误信息，可在工作线程中调用
+     * @param dirPath 科目目录路径（用于计算相对路径）
+     * @param filePath 题库文件路径
+     * @param errorOut 文件无效时输出错误信息，可为空
+     * @return 题库信息列表，文件无效或不含支持的题型时为空
+     */
+    static QVector<QuestionBankInfo> scanBankFile(const QString &dirPath, const QString &filePath, QString *errorOut = nullptr);
+    
     /**
      * @brief 验证题库文件是否有效
      * @param filePath 题库文件路径
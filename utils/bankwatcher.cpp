@@ -0,0 +1,353 @@
+#include "bankwatcher.h"
+#include "bankscanner.h"
+#include "../core/configmanager.h"
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QDebug>
+#include <QtConcurrent/QtConcurrentMap>
+#include <algorithm>
+
+struct WatchedFileScan {
+    QString dirPath;
+    QString filePath;
+    QDateTime lastModified;
+    qint64 size = -1;
+    QVector<QuestionBankInfo> banks;
+};
+
+// 一次遍历科目目录，同时得到需要监听的子目录和题库文件（与listBankFiles一样按路径排序）
+static void listSubjectTree(const QString &dirPath, QStringList &dirs, QStringList &files)
+{
+    dirs.clear();
+    files.clear();
+    if (!QDir(dirPath).exists()) {
+        return;
+    }
+
+    // AllDirs使目录不受名称过滤影响
+    QDirIterator it(dirPath, QStringList() << "*.json",
+                    QDir::AllDirs | QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QString path = it.next();
+        if (it.fileInfo().isDir()) {
+            dirs.append(path);
+        } else {
+            files.append(path);
+        }
+    }
+    std::sort(files.begin(), files.end());
+}
+
+static WatchedFileScan scanWatchedFile(const WatchedFileScan &task)
+{
+    WatchedFileScan result = task;
+    const QFileInfo fileInfo(task.filePath);
+    result.lastModified = fileInfo.lastModified();
+    result.size = fileInfo.size();
+    result.banks = BankScanner::scanBankFile(task.dirPath, task.filePath);
+    return result;
+}
+
+BankWatcher::BankWatcher(QObject *parent)
+    : QObject(parent)
+    , m_configManager(nullptr)
+    , m_watcher(new QFileSystemWatcher(this))
+    , m_debounceTimer(new QTimer(this))
+{
+    m_debounceTimer->setSingleShot(true);
+    m_debounceTimer->setInterval(500);
+
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged,
+            this, &BankWatcher::onPathChanged);
+    connect(m_watcher, &QFileSystemWatcher::fileChanged,
+            this, &BankWatcher::onPathChanged);
+    connect(m_debounceTimer, &QTimer::timeout,
+            this, &BankWatcher::processPendingSubjects);
+}
+
+BankWatcher::~BankWatcher()
+{
+}
+
+void BankWatcher::setConfigManager(ConfigManager *configManager)
+{
+    m_configManager = configManager;
+    syncWatchedSubjects();
+}
+
+void BankWatcher::setDebounceInterval(int msec)
+{
+    m_debounceTimer->setInterval(qMax(0, msec));
+}
+
+void BankWatcher::syncWatchedSubjects()
+{
+    if (!m_configManager) {
+        return;
+    }
+
+    const QStringList subjects = m_configManager->getAvailableSubjects();
+    const QSet<QString> currentSubjects(subjects.begin(), subjects.end());
+
+    // 移除已删除或路径发生变化的科目
+    const QStringList watchedSubjects = m_subjects.keys();
+    for (const QString &subject : watchedSubjects) {
+        if (!currentSubjects.contains(subject) ||
+            m_subjects.value(subject).dirPath != m_configManager->getSubjectPath(subject)) {
+            unwatchSubject(subject);
+            m_subjects.remove(subject);
+            m_pendingSubjects.remove(subject);
+        }
+    }
+
+    for (const QString &subject : subjects) {
+        if (m_subjects.contains(subject)) {
+            continue;
+        }
+        SubjectState state;
+        state.dirPath = m_configManager->getSubjectPath(subject);
+        QStringList dirs;
+        QStringList files;
+        listSubjectTree(state.dirPath, dirs, files);
+        seedSubjectCache(subject, state, files);
+        m_subjects.insert(subject, state);
+        watchSubjectPaths(subject, state, dirs, files);
+    }
+}
+
+void BankWatcher::onPathChanged(const QString &path)
+{
+    const QString subject = m_pathToSubject.value(path);
+    if (subject.isEmpty()) {
+        return;
+    }
+
+    // 批量复制时会连续触发大量事件，重新计时，等待静默后统一处理
+    m_pendingSubjects.insert(subject);
+    m_debounceTimer->start();
+}
+
+void BankWatcher::processPendingSubjects()
+{
+    QStringList subjects = m_pendingSubjects.values();
+    m_pendingSubjects.clear();
+    std::sort(subjects.begin(), subjects.end());
+
+    for (const QString &subject : subjects) {
+        if (refreshSubject(subject)) {
+            emit subjectBanksChanged(subject);
+        }
+    }
+}
+
+bool BankWatcher::refreshSubject(const QString &subject)
+{
+    if (!m_configManager || !m_subjects.contains(subject)) {
+        return false;
+    }
+
+    SubjectState &state = m_subjects[subject];
+    bool changed = false;
+
+    // 每次刷新只遍历一次目录，文件列表同时用于比较和更新监听路径
+    QStringList dirs;
+    QStringList files;
+    listSubjectTree(state.dirPath, dirs, files);
+
+    if (!state.cached) {
+        // 兜底：没有可用的启动扫描结果时完整扫描一次，之后只扫描变化的文件
+        rebuildSubjectCache(state, files);
+        changed = true;
+    } else {
+        QSet<QString> present;
+        for (const QString &filePath : files) {
+            present.insert(filePath);
+
+            const QFileInfo fileInfo(filePath);
+            auto it = state.files.find(filePath);
+            if (it != state.files.end() &&
+                it->lastModified == fileInfo.lastModified() &&
+                it->size == fileInfo.size()) {
+                continue;
+            }
+
+            FileEntry entry;
+            entry.lastModified = fileInfo.lastModified();
+            entry.size = fileInfo.size();
+            entry.banks = BankScanner::scanBankFile(state.dirPath, filePath);
+            state.files.insert(filePath, entry);
+            changed = true;
+        }
+
+        for (auto it = state.files.begin(); it != state.files.end();) {
+            if (!present.contains(it.key())) {
+                it = state.files.erase(it);
+                changed = true;
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // 新建的子目录、被替换的文件需要重新加入监听，已删除的路径不再保留
+    watchSubjectPaths(subject, state, dirs, files);
+
+    if (!changed) {
+        return false;
+    }
+
+    m_configManager->applyScannedBank(subject, assembleBank(subject, state));
+    qDebug() << "BankWatcher refreshed subject:" << subject << "files:" << state.files.size();
+    return true;
+}
+
+void BankWatcher::seedSubjectCache(const QString &subject, SubjectState &state, const QStringList &files)
+{
+    if (!m_configManager->hasQuestionBank(subject)) {
+        return;
+    }
+
+    // 启动时的全量扫描结果已经合并在ConfigManager中，按文件分组作为初始缓存，
+    // 科目第一次发生变化时只需扫描变化的文件
+    QHash<QString, QVector<QuestionBankInfo>> banksByFile;
+    const QVector<QuestionBankInfo> banks = m_configManager->getQuestionBank(subject).getAllBanks();
+    for (const QuestionBankInfo &info : banks) {
+        const QString filePath = QuestionBank::resolveBankFilePath(state.dirPath, info.src, info.type);
+        banksByFile[QDir::cleanPath(QFileInfo(filePath).absoluteFilePath())].append(info);
+    }
+
+    state.files.clear();
+    for (const QString &filePath : files) {
+        const QFileInfo fileInfo(filePath);
+        FileEntry entry;
+        entry.lastModified = fileInfo.lastModified();
+        entry.size = fileInfo.size();
+        entry.banks = banksByFile.value(QDir::cleanPath(fileInfo.absoluteFilePath()));
+        state.files.insert(filePath, entry);
+    }
+    state.cached = true;
+}
+
+void BankWatcher::rebuildSubjectCache(SubjectState &state, const QStringList &files)
+{
+    state.files.clear();
+
+    QList<WatchedFileScan> tasks;
+    for (const QString &filePath : files) {
+        WatchedFileScan task;
+        task.dirPath = state.dirPath;
+        task.filePath = filePath;
+        tasks.append(task);
+    }
+
+    const QList<WatchedFileScan> results = QtConcurrent::blockingMapped(tasks, scanWatchedFile);
+    for (const WatchedFileScan &result : results) {
+        FileEntry entry;
+        entry.lastModified = result.lastModified;
+        entry.size = result.size;
+        entry.banks = result.banks;
+        state.files.insert(result.filePath, entry);
+    }
+
+    state.cached = true;
+}
+
+void BankWatcher::watchSubjectPaths(const QString &subject, const SubjectState &state,
+                                    const QStringList &dirs, const QStringList &files)
+{
+    QSet<QString> paths;
+    if (QDir(state.dirPath).exists()) {
+        paths.insert(state.dirPath);
+        paths.unite(QSet<QString>(dirs.begin(), dirs.end()));
+        paths.unite(QSet<QString>(files.begin(), files.end()));
+    }
+
+    const QStringList watchedDirs = m_watcher->directories();
+    const QStringList watchedFiles = m_watcher->files();
+    QSet<QString> watched(watchedDirs.begin(), watchedDirs.end());
+    watched.unite(QSet<QString>(watchedFiles.begin(), watchedFiles.end()));
+
+    // 已删除的文件和目录从映射和监听中移除，映射不会随着文件增删无限增长
+    QStringList toRemove;
+    for (auto it = m_pathToSubject.begin(); it != m_pathToSubject.end();) {
+        if (it.value() == subject && !paths.contains(it.key())) {
+            if (watched.contains(it.key())) {
+                toRemove.append(it.key());
+            }
+            it = m_pathToSubject.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    if (!toRemove.isEmpty()) {
+        m_watcher->removePaths(toRemove);
+    }
+
+    QStringList toAdd;
+    for (const QString &path : paths) {
+        if (!watched.contains(path)) {
+            toAdd.append(path);
+        }
+        m_pathToSubject.insert(path, subject);
+    }
+
+    if (!toAdd.isEmpty()) {
+        const QStringList failed = m_watcher->addPaths(toAdd);
+        if (!failed.isEmpty()) {
+            qWarning() << "BankWatcher failed to watch" << failed.size() << "paths for subject:" << subject;
+        }
+    }
+}
+
+void BankWatcher::unwatchSubject(const QString &subject)
+{
+    QStringList paths;
+    for (auto it = m_pathToSubject.begin(); it != m_pathToSubject.end();) {
+        if (it.value() == subject) {
+            paths.append(it.key());
+            it = m_pathToSubject.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    const QStringList watchedDirs = m_watcher->directories();
+    const QStringList watchedFiles = m_watcher->files();
+    QSet<QString> watched(watchedDirs.begin(), watchedDirs.end());
+    watched.unite(QSet<QString>(watchedFiles.begin(), watchedFiles.end()));
+
+    QStringList toRemove;
+    for (const QString &path : paths) {
+        if (watched.contains(path)) {
+            toRemove.append(path);
+        }
+    }
+    if (!toRemove.isEmpty()) {
+        m_watcher->removePaths(toRemove);
+    }
+}
+
+QuestionBank BankWatcher::assembleBank(const QString &subject, const SubjectState &state) const
+{
+    // 与BankScanner保持一致：按文件路径排序后依次加入，保证题库顺序稳定
+    QStringList files = state.files.keys();
+    std::sort(files.begin(), files.end());
+
+    QuestionBank bank(subject);
+    for (const QString &filePath : files) {
+        const FileEntry entry = state.files.value(filePath);
+        for (const QuestionBankInfo &info : entry.banks) {
+            if (info.type == QuestionType::Choice) {
+                bank.addChoiceBank(info);
+            } else if (info.type == QuestionType::TrueOrFalse) {
+                bank.addTrueOrFalseBank(info);
+            } else if (info.type == QuestionType::FillBlank) {
+                bank.addFillBlankBank(info);
+            }
+        }
+    }
+    return bank;
+}
@@ -0,0 +1,89 @@
+#ifndef BANKWATCHER_H
+#define BANKWATCHER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include <QDateTime>
+#include "../models/questionbank.h"
+
+class QFileSystemWatcher;
+class QTimer;
+class ConfigManager;
+
+/**
+ * @brief 题库目录监听服务
+ *
+ * 使用QFileSystemWatcher监听各科目目录及其中的题库文件，
+ * 外部修改（如转换脚本写入新题库）经过防抖后只重新扫描发生变化的文件，
+ * 再通过ConfigManager合并到题库信息中并发出通知
+ */
+class BankWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit BankWatcher(QObject *parent = nullptr);
+    ~BankWatcher();
+
+    /**
+     * @brief 设置配置管理器并开始监听其中的所有科目
+     * @param configManager 配置管理器
+     */
+    void setConfigManager(ConfigManager *configManager);
+
+    /**
+     * @brief 根据当前科目列表同步监听路径（科目增删后调用）
+     */
+    void syncWatchedSubjects();
+
+    /**
+     * @brief 设置防抖间隔，批量复制文件时只触发一次扫描
+     * @param msec 间隔毫秒数
+     */
+    void setDebounceInterval(int msec);
+
+signals:
+    /**
+     * @brief 科目的题库信息已根据磁盘变化更新
+     * @param subject 科目名称
+     */
+    void subjectBanksChanged(const QString &subject);
+
+private slots:
+    void onPathChanged(const QString &path);
+    void processPendingSubjects();
+
+private:
+    struct FileEntry {
+        QDateTime lastModified;
+        qint64 size = -1;
+        QVector<QuestionBankInfo> banks;
+    };
+
+    struct SubjectState {
+        QString dirPath;
+        bool cached = false;            // 是否已建立逐文件缓存
+        QHash<QString, FileEntry> files; // 文件路径 -> 扫描结果
+    };
+
+    bool refreshSubject(const QString &subject);
+    void seedSubjectCache(const QString &subject, SubjectState &state, const QStringList &files);
+    void rebuildSubjectCache(SubjectState &state, const QStringList &files);
+    void watchSubjectPaths(const QString &subject, const SubjectState &state,
+                           const QStringList &dirs, const QStringList &files);
+    void unwatchSubject(const QString &subject);
+    QuestionBank assembleBank(const QString &subject, const SubjectState &state) const;
+
+    ConfigManager *m_configManager;
+    QFileSystemWatcher *m_watcher;
+    QTimer *m_debounceTimer;
+    QHash<QString, SubjectState> m_subjects;
+    QHash<QString, QString> m_pathToSubject; // 被监听路径 -> 科目名称
+    QSet<QString> m_pendingSubjects;
+};
+
+#endif // BANKWATCHER_H
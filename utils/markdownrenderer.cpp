@@ -1,27 +1,67 @@
 #include "markdownrenderer.h"
+#include "markdowntokenizer.h"
+#include "mathprerenderer.h"
+#include "resourceschemehandler.h"
 #include <QWebEngineSettings>
 #include <QWebEngineProfile>
+#include <QWebEnginePage>
 #include <QRegularExpression>
 #include <QDebug>
 #include <QCoreApplication>
 #include <QUrl>
-#include <QStack>
 #include <QDir>
 #include <QFileInfo>
 #include <QTimer>
 #include <QResizeEvent>
+#include <QShowEvent>
+#include <QWebChannel>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QPointer>
+#include <QCache>
+#include <QCryptographicHash>
+#include <QLabel>
+#include <QDesktopServices>
+#include <QImageReader>
+
+bool MarkdownRendererPage::acceptNavigationRequest(const QUrl &url, NavigationType type, bool isMainFrame)
+{
+    // 点击题目中的链接时交给系统浏览器，否则页面会离开模板，之后无法再原地更新内容
+    if (type == NavigationTypeLinkClicked && isMainFrame) {
+        QDesktopServices::openUrl(url);
+        return false;
+    }
+    return QWebEnginePage::acceptNavigationRequest(url, type, isMainFrame);
+}
 
 MarkdownRenderer::MarkdownRenderer(QWidget *parent)
     : QWidget(parent)
     , m_webView(nullptr)
+    , m_nativeView(nullptr)
+    , m_webChannel(nullptr)
+    , m_bridge(nullptr)
     , m_layout(nullptr)
     , m_currentTheme("default")
     , m_autoResize(false)
     , m_maxAutoHeight(0)
     , m_parentMaxHeight(0)
-    , m_resizePending(false)
+    , m_reportedHeight(0)
+    , m_choicesEnabled(true)
+    , m_inPlaceUpdates(true)
+    , m_pageState(PageState::Empty)
+    , m_templateLoadRequested(false)
+    , m_recoveringFromCrash(false)
+    , m_hasPendingContent(false)
+    , m_nativeRendering(true)
+    , m_backend(Backend::Native)
+    , m_viewMinimumHeight(0)
+    , m_viewMaximumHeight(QWIDGETSIZE_MAX)
 {
-    setupWebEngine();
+    m_layout = new QVBoxLayout(this);
+    m_layout->setContentsMargins(0, 0, 0, 0);
+    
+    // WebEngine视图在第一次遇到公式、表格或代码时才创建
+    setupNativeView();
     createHtmlTemplate();
 }
 
@@ -29,13 +69,35 @@ MarkdownRenderer::~MarkdownRenderer()
 {
 }
 
+void MarkdownRenderer::setupNativeView()
+{
+    m_nativeView = new QLabel(this);
+    m_nativeView->setTextFormat(Qt::RichText);
+    m_nativeView->setWordWrap(true);
+    m_nativeView->setAlignment(Qt::AlignLeft | Qt::AlignTop);
+    m_nativeView->setTextInteractionFlags(Qt::TextSelectableByMouse | Qt::LinksAccessibleByMouse);
+    m_nativeView->setContentsMargins(10, 10, 10, 10);
+    m_nativeView->setStyleSheet("QLabel { background-color: white; "
+                                "font-family: 'Microsoft YaHei', Arial, sans-serif; font-size: 14px; }");
+    m_layout->addWidget(m_nativeView);
+    
+    connect(m_nativeView, &QLabel::linkActivated,
+            this, &MarkdownRenderer::onNativeLinkActivated);
+}
+
 void MarkdownRenderer::setupWebEngine()
 {
-    m_layout = new QVBoxLayout(this);
-    m_layout->setContentsMargins(0, 0, 0, 0);
+    if (m_webView) {
+        return;
+    }
     
     m_webView = new QWebEngineView(this);
+    // 所有渲染器共用同一个Profile，KaTeX资源和图片由内存资源协议提供
+    m_webView->setPage(new MarkdownRendererPage(ResourceSchemeHandler::sharedProfile(), m_webView));
     m_webView->setContextMenuPolicy(Qt::NoContextMenu);
+    m_webView->setMinimumHeight(m_viewMinimumHeight);
+    m_webView->setMaximumHeight(m_viewMaximumHeight);
+    m_webView->setVisible(m_backend == Backend::WebEngine);
     
     // 配置WebEngine设置
     QWebEngineSettings *settings = m_webView->settings();
@@ -46,8 +108,140 @@ void MarkdownRenderer::setupWebEngine()
     
     m_layout->addWidget(m_webView);
     
+    // 页面中的选项点击通过QWebChannel回传
+    m_bridge = new MarkdownRendererBridge(this);
+    m_webChannel = new QWebChannel(this);
+    m_webChannel->registerObject(QStringLiteral("bridge"), m_bridge);
+    m_webView->page()->setWebChannel(m_webChannel);
+    connect(m_bridge, &MarkdownRendererBridge::choiceActivated,
+            this, &MarkdownRenderer::choiceClicked);
+    connect(m_bridge, &MarkdownRendererBridge::contentHeightChanged,
+            this, &MarkdownRenderer::onContentHeightReported);
+    
+    connect(m_webView, &QWebEngineView::loadStarted,
+            this, &MarkdownRenderer::onLoadStarted);
     connect(m_webView, &QWebEngineView::loadFinished,
             this, &MarkdownRenderer::onLoadFinished);
+    connect(m_webView->page(), &QWebEnginePage::renderProcessTerminated,
+            this, &MarkdownRenderer::onRenderProcessTerminated);
+}
+
+void MarkdownRenderer::warmUpWebEngine()
+{
+    setupWebEngine();
+}
+
+void MarkdownRenderer::switchBackend(Backend backend)
+{
+    if (backend == Backend::WebEngine) {
+        setupWebEngine();
+    }
+    m_backend = backend;
+    m_nativeView->setVisible(backend == Backend::Native);
+    if (m_webView) {
+        m_webView->setVisible(backend == Backend::WebEngine);
+    }
+}
+
+bool MarkdownRenderer::isNativeRenderable(const QString &markdown)
+{
+    // 公式、代码和表格交给WebEngine，其余语法QLabel的富文本都能显示
+    bool lineStart = true;
+    for (const QChar c : markdown) {
+        if (c == QLatin1Char('$') || c == QLatin1Char('`')) {
+            return false;
+        }
+        if (lineStart && c == QLatin1Char('|')) {
+            return false;
+        }
+        if (c == QLatin1Char('\n')) {
+            lineStart = true;
+        } else if (!c.isSpace()) {
+            lineStart = false;
+        }
+    }
+    return true;
+}
+
+void MarkdownRenderer::showNativeContent()
+{
+    switchBackend(Backend::Native);
+    
+    static const QString nativeStyle =
+        "<style>"
+        "strong { color: #2c3e50; } em { color: #7f8c8d; } del { color: #95a5a6; }"
+        "a { color: #3498db; text-decoration: none; }"
+        "blockquote { background-color: #ecf0f1; font-style: italic; }"
+        "h1 { font-size: 22px; } h2 { font-size: 18px; } h3 { font-size: 16px; }"
+        "h4 { font-size: 15px; } h5 { font-size: 14px; } h6 { font-size: 12px; }"
+        "</style>";
+    
+    QString html = nativeStyle + m_nativeQuestionHtml;
+    if (!m_nativeChoiceHtml.isEmpty()) {
+        html += "<table width=\"100%\" cellspacing=\"4\" cellpadding=\"6\">";
+        for (int i = 0; i < m_nativeChoiceHtml.size() && i < m_nativeChoiceLabels.size(); ++i) {
+            const bool selected = m_selectedChoices.contains(i);
+            html += QString("<tr><td width=\"32\" bgcolor=\"%1\"><a href=\"choice:%2\"><b>%3.</b></a></td>"
+                            "<td bgcolor=\"%1\">%4</td></tr>")
+                        .arg(selected ? "#e7f1ff" : "#ffffff")
+                        .arg(i)
+                        .arg(m_nativeChoiceLabels[i].toHtmlEscaped(), m_nativeChoiceHtml[i]);
+        }
+        html += "</table>";
+    }
+    
+    m_nativeView->setText(constrainNativeImages(html));
+    
+    if (m_autoResize) {
+        scheduleAutoHeight();
+    }
+}
+
+QString MarkdownRenderer::constrainNativeImages(const QString &html) const
+{
+    // QLabel不支持max-width，超出可用宽度的图片按宽度缩放
+    static const QRegularExpression imageRegex("<img src=\"([^\"]*)\"");
+    if (!html.contains("<img ")) {
+        return html;
+    }
+    
+    const int availableWidth = qMax(100, (width() > 0 ? width() : 600) - 20);
+    QString result = html;
+    QList<QRegularExpressionMatch> matches;
+    QRegularExpressionMatchIterator it = imageRegex.globalMatch(html);
+    while (it.hasNext()) {
+        matches.append(it.next());
+    }
+    for (int i = matches.size() - 1; i >= 0; --i) {
+        const QRegularExpressionMatch &match = matches[i];
+        const QUrl url(QString(match.captured(1)).replace("&amp;", "&"));
+        if (!url.isLocalFile()) {
+            continue;
+        }
+        const QSize imageSize = QImageReader(url.toLocalFile()).size();
+        if (imageSize.width() > availableWidth) {
+            result.insert(match.capturedEnd(), QString(" width=\"%1\"").arg(availableWidth));
+        }
+    }
+    return result;
+}
+
+void MarkdownRenderer::onNativeLinkActivated(const QString &link)
+{
+    if (link.startsWith("choice:")) {
+        bool ok = false;
+        const int index = link.mid(7).toInt(&ok);
+        if (ok && m_choicesEnabled) {
+            emit choiceClicked(index);
+        }
+        return;
+    }
+    QDesktopServices::openUrl(QUrl(link));
+}
+
+void MarkdownRenderer::setNativeRendering(bool enabled)
+{
+    m_nativeRendering = enabled;
 }
 
 void MarkdownRenderer::createHtmlTemplate()
@@ -76,9 +270,60 @@ void MarkdownRenderer::createHtmlTemplate()
     <!-- KaTeX JS -->
     <script src="katex/katex.min.js"></script>
     <script defer src="katex/contrib/auto-render.min.js"></script>
+    <script src="qrc:///qtwebchannel/qwebchannel.js"></script>
     
     <script>
-        document.addEventListener('DOMContentLoaded', function() {
+        var bridge = null;
+        if (typeof QWebChannel !== 'undefined' && typeof qt !== 'undefined') {
+            new QWebChannel(qt.webChannelTransport, function(channel) {
+                bridge = channel.objects.bridge;
+                reportHeight();
+            });
+        }
+        
+        // 内容高度由页面主动上报：同一帧内的多次变化只上报一次
+        function reportHeight() {
+            if (bridge) {
+                bridge.reportContentHeight(document.body.scrollHeight);
+            }
+        }
+        
+        var heightFrame = 0;
+        function scheduleHeightReport() {
+            if (heightFrame) {
+                return;
+            }
+            heightFrame = requestAnimationFrame(function() {
+                heightFrame = 0;
+                reportHeight();
+            });
+        }
+        
+        if (typeof ResizeObserver !== 'undefined') {
+            new ResizeObserver(scheduleHeightReport).observe(document.body);
+        }
+        
+        document.addEventListener('click', function(event) {
+            var choice = event.target.closest('.choice');
+            if (!choice || document.body.classList.contains('choices-disabled') || !bridge) {
+                return;
+            }
+            bridge.choiceClicked(parseInt(choice.getAttribute('data-index'), 10));
+        });
+        
+        function setSelectedChoices(indices) {
+            var choices = document.querySelectorAll('.choice');
+            for (var i = 0; i < choices.length; ++i) {
+                var index = parseInt(choices[i].getAttribute('data-index'), 10);
+                choices[i].classList.toggle('selected', indices.indexOf(index) >= 0);
+            }
+        }
+        
+        function setChoicesEnabled(enabled) {
+            document.body.classList.toggle('choices-disabled', !enabled);
+        }
+        
+        function renderMath(element) {
             if (typeof renderMathInElement !== 'undefined') {
                 var options = {};
                 options.delimiters = [];
@@ -90,10 +335,30 @@ void MarkdownRenderer::createHtmlTemplate()
                 options.throwOnError = false;
                 // 设置trust为false，确保<和>被视为文本而不是HTML标签
                 options.trust = false;
-                renderMathInElement(document.body, options);
+                renderMathInElement(element, options);
             } else {
                 console.error('renderMathInElement is not defined. KaTeX auto-render may not be loaded.');
             }
+        }
+        
+        // 原地更新内容：只替换#content并重新排版其中的公式，不重新加载KaTeX和整个页面
+        // 公式已全部预渲染时typeset为false，跳过排版
+        function updateContent(html, typeset) {
+            var content = document.getElementById('content');
+            content.innerHTML = html;
+            if (typeset) {
+                renderMath(content);
+            }
+            // 隐藏的页面（预取）中requestAnimationFrame和ResizeObserver会被节流，
+            // 先同步上报一次，换上显示时高度已经正确
+            reportHeight();
+            scheduleHeightReport();
+        }
+        
+        document.addEventListener('DOMContentLoaded', function() {
+            if (%TYPESET%) {
+                renderMath(document.body);
+            }
         });
     </script>
 </body>
@@ -101,458 +366,57 @@ void MarkdownRenderer::createHtmlTemplate()
     )";
 }
 
-QString MarkdownRenderer::convertMarkdownToHtml(const QString &markdown)
+// 已转换HTML的LRU缓存，所有渲染器共享；成本按HTML字符数计算
+static QCache<QByteArray, QString> &htmlCache()
 {
-    QString html = markdown;
-    
-    // 使用统一的保护机制处理所有需要避免HTML转义的内容
-    html = protectSpecialContent(html);
-    
-    // HTML特殊字符转义（在保护特殊内容之后进行）
-    html = escapeHtmlSpecialChars(html);
-        
-    // 处理多行空行：将多个连续空行合并为一个
-    html.replace(QRegularExpression("\n\\s*\n\\s*\n+"), "\n\n");
-    
-    // 标题 (支持1-6级标题)
-    html.replace(QRegularExpression("^###### (.+)$", QRegularExpression::MultilineOption), "<h6>\\1</h6>");
-    html.replace(QRegularExpression("^##### (.+)$", QRegularExpression::MultilineOption), "<h5>\\1</h5>");
-    html.replace(QRegularExpression("^#### (.+)$", QRegularExpression::MultilineOption), "<h4>\\1</h4>");
-    html.replace(QRegularExpression("^### (.+)$", QRegularExpression::MultilineOption), "<h3>\\1</h3>");
-    html.replace(QRegularExpression("^## (.+)$", QRegularExpression::MultilineOption), "<h2>\\1</h2>");
-    html.replace(QRegularExpression("^# (.+)$", QRegularExpression::MultilineOption), "<h1>\\1</h1>");
-    
-    // 粗斜体 (必须在粗体和斜体之前处理)
-    html.replace(QRegularExpression("\\*\\*\\*(.+?)\\*\\*\\*"), "<strong><em>\\1</em></strong>");
-    // html.replace(QRegularExpression("___(.+?)___"), "<strong><em>\\1</em></strong>");
-    
-    // 粗体
-    html.replace(QRegularExpression("\\*\\*(.+?)\\*\\*"), "<strong>\\1</strong>");
-    // html.replace(QRegularExpression("__(.+?)__"), "<strong>\\1</strong>");
-    
-    html.replace(QRegularExpression("\\*(.+?)\\*"), "<em>\\1</em>");
-    // html.replace(QRegularExpression("_(.+?)_"), "<em>\\1</em>");
-    
-    // 删除线
-    html.replace(QRegularExpression("~~(.+?)~~"), "<del>\\1</del>");
-    
-    // 行内代码
-    html.replace(QRegularExpression("`(.+?)`"), "<code>\\1</code>");
-    
-    // 图片 ![alt](src)
-    {
-        QRegularExpression imageRegex("!\\[([^\\]]*)\\]\\(([^\\)]+)\\)");
-        QList<QRegularExpressionMatch> matches;
-        QRegularExpressionMatchIterator it = imageRegex.globalMatch(html);
-        while (it.hasNext()) {
-            matches.append(it.next());
-        }
-        for (int i = matches.size() - 1; i >= 0; --i) {
-            const QRegularExpressionMatch match = matches[i];
-            const QString altText = match.captured(1);
-            const QString rawSrc = match.captured(2).trimmed();
-
-            QString resolvedSrc = rawSrc;
-            const QString key = rawSrc.trimmed();
-            if (!key.isEmpty() && m_images.contains(key)) {
-                const QString mapped = m_images.value(key).trimmed();
-                if (!mapped.isEmpty()) {
-                    resolvedSrc = mapped;
-                }
-            }
-
-            QUrl finalUrl;
-            if (resolvedSrc.startsWith("http://", Qt::CaseInsensitive) ||
-                resolvedSrc.startsWith("https://", Qt::CaseInsensitive) ||
-                resolvedSrc.startsWith("file://", Qt::CaseInsensitive)) {
-                finalUrl = QUrl(resolvedSrc);
-            } else if (QDir::isAbsolutePath(resolvedSrc)) {
-                QString chosenPath = resolvedSrc;
-                if (!m_imageBaseDir.trimmed().isEmpty()) {
-                    const QString fileName = QFileInfo(resolvedSrc).fileName();
-                    if (!fileName.isEmpty()) {
-                        const QString localCandidate = QDir(m_imageBaseDir).filePath(QString("asset/%1").arg(fileName));
-                        if (QFileInfo::exists(localCandidate)) {
-                            chosenPath = localCandidate;
-                        }
-                    }
-                }
-                finalUrl = QUrl::fromLocalFile(chosenPath);
-            } else if (!m_imageBaseDir.trimmed().isEmpty()) {
-                const QString absPath = QDir(m_imageBaseDir).filePath(resolvedSrc);
-                finalUrl = QUrl::fromLocalFile(absPath);
-            } else {
-                finalUrl = QUrl(resolvedSrc);
-            }
-
-            const QString imgTag = QString("<img src=\"%1\" alt=\"%2\" />")
-                .arg(finalUrl.toString().toHtmlEscaped(), altText);
-
-            html.replace(match.capturedStart(), match.capturedLength(), imgTag);
-        }
-    }
-
-    // 链接 [text](url)
-    html.replace(QRegularExpression("(?<!\\!)\\[([^\\]]+)\\]\\(([^\\)]+)\\)"), "<a href=\"\\2\">\\1</a>");
-    
-    // 水平分割线
-    html.replace(QRegularExpression("^---+$", QRegularExpression::MultilineOption), "<hr>");
-    html.replace(QRegularExpression("^\\*\\*\\*+$", QRegularExpression::MultilineOption), "<hr>");
-    
-    // 处理列表
-    html = processLists(html);
-    
-    // 处理表格
-    html = processTables(html);
-    
-    // 段落处理
-    html = processParagraphs(html);
-
-    // 最后恢复并处理被保护的内容，避免代码块/行内代码被二次渲染
-    html = restoreAndProcessProtectedContent(html);
-    
-    return html;
+    static QCache<QByteArray, QString> cache(8 * 1024 * 1024);
+    return cache;
 }
 
-QString MarkdownRenderer::processCodeBlocks(const QString &html)
+static QByteArray htmlCacheKey(const QString &markdown, const QMap<QString, QString> &images, const QString &imageBaseDir)
 {
-    QString result = html;
-    QRegularExpression codeBlockRegex("```([^\\r\\n]*)\\R?([\\s\\S]*?)```",
-                                      QRegularExpression::DotMatchesEverythingOption);
-    QRegularExpression languageRegex("^[A-Za-z][A-Za-z0-9_+\\-]{0,19}$");
-    
-    // 从后往前替换，避免位置偏移问题
-    QList<QRegularExpressionMatch> matches;
-    QRegularExpressionMatchIterator iterator = codeBlockRegex.globalMatch(result);
-    while (iterator.hasNext()) {
-        matches.append(iterator.next());
-    }
-    
-    for (int i = matches.size() - 1; i >= 0; --i) {
-        QRegularExpressionMatch match = matches[i];
-        const QString fenceInfo = match.captured(1);
-        const QString body = match.captured(2);
-
-        QString language;
-        QString code;
-
-        const QString trimmedFenceInfo = fenceInfo.trimmed();
-        if (!trimmedFenceInfo.isEmpty() && languageRegex.match(trimmedFenceInfo).hasMatch()) {
-            language = trimmedFenceInfo;
-            code = body;
-        } else {
-            language.clear();
-            code = fenceInfo;
-            if (code.startsWith(' ')) {
-                code = code.mid(1);
-            }
-            if (!body.isEmpty()) {
-                if (!code.isEmpty()) {
-                    code += "\n";
-                }
-                code += body;
-            }
-        }
-
-        code.replace("\r\n", "\n");
-        code.replace("\r", "\n");
-        if (code.endsWith('\n')) {
-            code.chop(1);
-        }
-
-        const QString escapedCode = code.toHtmlEscaped();
-        QString codeBlock;
-        if (!language.isEmpty()) {
-            codeBlock = QString("<pre><code class=\"language-%1\">%2</code></pre>")
-                       .arg(language, escapedCode);
-        } else {
-            codeBlock = QString("<pre><code>%1</code></pre>").arg(escapedCode);
-        }
-        
-        result.replace(match.capturedStart(), match.capturedLength(), codeBlock);
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(markdown.toUtf8());
+    hash.addData(QByteArray(1, '\0'));
+    for (auto it = images.constBegin(); it != images.constEnd(); ++it) {
+        hash.addData(it.key().toUtf8());
+        hash.addData(QByteArray(1, '\x1f'));
+        hash.addData(it.value().toUtf8());
+        hash.addData(QByteArray(1, '\x1e'));
     }
-    
-    return result;
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(imageBaseDir.toUtf8());
+    // 有新的公式预渲染结果后，之前转换的HTML需要重新生成
+    hash.addData(QByteArray::number(MathPrerenderer::generation()));
+    return hash.result();
 }
 
-QString MarkdownRenderer::processLatexBlocks(const QString &html)
+void MarkdownRenderer::setHtmlCacheCapacity(int maxChars)
 {
-    QString result = html;
-    
-    // 先处理双美元符号的LaTeX公式
-    QRegularExpression latexBlockRegex("\\$\\$([^$]*?)\\$\\$", QRegularExpression::DotMatchesEverythingOption);
-    QList<QRegularExpressionMatch> blockMatches;
-    QRegularExpressionMatchIterator blockIterator = latexBlockRegex.globalMatch(result);
-    while (blockIterator.hasNext()) {
-        blockMatches.append(blockIterator.next());
-    }
-    
-    // 从后往前替换，避免位置偏移问题
-    for (int i = blockMatches.size() - 1; i >= 0; --i) {
-        QRegularExpressionMatch match = blockMatches[i];
-        QString latexContent = match.captured(1).trimmed();
-        QString latexBlock = QString("$$%1$$").arg(latexContent);
-        result.replace(match.capturedStart(), match.capturedLength(), latexBlock);
-    }
-    
-    // 再处理单美元符号的LaTeX公式
-    QRegularExpression singleLatexRegex("\\$([^$\\n]*?)\\$");
-    QList<QRegularExpressionMatch> singleMatches;
-    QRegularExpressionMatchIterator singleIterator = singleLatexRegex.globalMatch(result);
-    while (singleIterator.hasNext()) {
-        singleMatches.append(singleIterator.next());
-    }
-    
-    // 从后往前替换，避免位置偏移问题
-    for (int i = singleMatches.size() - 1; i >= 0; --i) {
-        QRegularExpressionMatch match = singleMatches[i];
-        QString latexContent = match.captured(1);
-        QString latexBlock = QString("$%1$").arg(latexContent);
-        result.replace(match.capturedStart(), match.capturedLength(), latexBlock);
-    }
-    
-    return result;
+    htmlCache().setMaxCost(qMax(0, maxChars));
 }
 
-QString MarkdownRenderer::escapeHtmlSpecialChars(const QString &html)
+void MarkdownRenderer::clearHtmlCache()
 {
-    QString result = html;
-    
-    // 转义HTML特殊字符
-    result.replace("&", "&amp;");  // 必须首先处理&，避免重复转义
-    result.replace("<", "&lt;");
-    result.replace(">", "&gt;");
-    result.replace('"', "&quot;");
-    
-    return result;
+    htmlCache().clear();
 }
 
-QString MarkdownRenderer::processParagraphs(const QString &html)
+QString MarkdownRenderer::convertMarkdownToHtml(const QString &markdown)
 {
-    const QStringList lines = html.split('\n');
-    QStringList outputLines;
-    QStringList paragraphLines;
-
-    auto flushParagraph = [&]() {
-        if (paragraphLines.isEmpty()) {
-            return;
-        }
-        outputLines.append("<p>" + paragraphLines.join(" ") + "</p>");
-        paragraphLines.clear();
-    };
-
-    for (const QString &rawLine : lines) {
-        const QString line = rawLine.trimmed();
-
-        if (line.isEmpty()) {
-            flushParagraph();
-            continue;
-        }
-
-        const bool isProtected = line.startsWith("__PROTECTED_");
-        const bool isBlockTag =
-            line.startsWith("<h") ||
-            line.startsWith("<ul") ||
-            line.startsWith("<ol") ||
-            line.startsWith("<li") ||
-            line.startsWith("<blockquote") ||
-            line.startsWith("<pre") ||
-            line.startsWith("<table") ||
-            line.startsWith("<tr") ||
-            line.startsWith("<th") ||
-            line.startsWith("<td") ||
-            line.startsWith("<hr") ||
-            line.startsWith("</");
-
-        if (isProtected || isBlockTag) {
-            flushParagraph();
-            outputLines.append(line);
-            continue;
-        }
-
-        paragraphLines.append(line);
+    // 同样的题目在一次练习或复习中会被反复渲染，命中缓存时跳过整个转换流程
+    const QByteArray key = htmlCacheKey(markdown, m_images, m_imageBaseDir);
+    if (const QString *cached = htmlCache().object(key)) {
+        return *cached;
     }
-
-    flushParagraph();
-
-    return outputLines.join('\n');
-}
-
-QString MarkdownRenderer::processLists(const QString &html)
-{
-    QString result = html;
     
-    // 处理列表（支持嵌套）
-    QStringList lines = result.split('\n');
-    QStringList processedLines;
-    QStack<QString> listStack; // 存储当前嵌套的列表类型
-    QStack<int> indentStack;   // 存储当前嵌套的缩进级别
-    QStack<int> olStartStack;  // 存储有序列表的起始编号
-    
-    for (const QString &line : lines) {
-        QString trimmedLine = line.trimmed();
-        
-        // 检查是否是列表项
-        QRegularExpression ulRegex("^[*+-]\\s+(.+)$");
-        QRegularExpression olRegex("^(\\d+)\\.\\s+(.+)$");
-        QRegularExpressionMatch ulMatch = ulRegex.match(trimmedLine);
-        QRegularExpressionMatch olMatch = olRegex.match(trimmedLine);
-        
-        if (ulMatch.hasMatch() || olMatch.hasMatch()) {
-            // 计算当前行的缩进级别
-            int currentIndent = line.length() - line.trimmed().length();
-            QString listType = ulMatch.hasMatch() ? "ul" : "ol";
-            QString content = ulMatch.hasMatch() ? ulMatch.captured(1) : olMatch.captured(2);
-            int olNumber = olMatch.hasMatch() ? olMatch.captured(1).toInt() : 1;
-            
-            // 处理嵌套逻辑
-            while (!indentStack.isEmpty() && currentIndent <= indentStack.top()) {
-                QString closingTag = "</" + listStack.pop() + ">";
-                processedLines.append(closingTag);
-                indentStack.pop();
-                if (!olStartStack.isEmpty()) {
-                    olStartStack.pop();
-                }
-            }
-            
-            // 如果是新的嵌套级别或不同类型的列表
-            if (indentStack.isEmpty() || currentIndent > indentStack.top() || 
-                (!listStack.isEmpty() && listStack.top() != listType)) {
-                if (!indentStack.isEmpty() && listStack.top() != listType) {
-                    // 关闭当前列表，开始新类型的列表
-                    QString closingTag = "</" + listStack.pop() + ">";
-                    processedLines.append(closingTag);
-                    indentStack.pop();
-                    if (!olStartStack.isEmpty()) {
-                        olStartStack.pop();
-                    }
-                }
-                
-                QString openingTag;
-                if (listType == "ol") {
-                    // 对于有序列表，添加start属性
-                    openingTag = QString("<ol start=\"%1\">").arg(olNumber);
-                    olStartStack.push(olNumber);
-                } else {
-                    openingTag = "<ul>";
-                }
-                processedLines.append(openingTag);
-                listStack.push(listType);
-                indentStack.push(currentIndent);
-            }
-            
-            processedLines.append("<li>" + content + "</li>");
-        } else {
-            // 非列表行，关闭所有打开的列表
-            while (!listStack.isEmpty()) {
-                QString closingTag = "</" + listStack.pop() + ">";
-                processedLines.append(closingTag);
-                indentStack.pop();
-                if (!olStartStack.isEmpty()) {
-                    olStartStack.pop();
-                }
-            }
-
-            processedLines.append(line);
-        }
-    }
-    
-    // 关闭剩余的列表
-    while (!listStack.isEmpty()) {
-        QString closingTag = "</" + listStack.pop() + ">";
-        processedLines.append(closingTag);
-        indentStack.pop();
-        if (!olStartStack.isEmpty()) {
-            olStartStack.pop();
-        }
-    }
-    
-    return processedLines.join('\n');
+    const QString html = renderMarkdownToHtml(markdown);
+    htmlCache().insert(key, new QString(html), qMax(1, html.size()));
+    return html;
 }
 
-QString MarkdownRenderer::processTables(const QString &html)
+QString MarkdownRenderer::renderMarkdownToHtml(const QString &markdown)
 {
-    QString result = html;
-    QRegularExpression tableRegex("(^\\|.+\\|$\n)+", QRegularExpression::MultilineOption);
-    QRegularExpressionMatchIterator tableIterator = tableRegex.globalMatch(result);
-    QStringList tableMatches;
-    
-    while (tableIterator.hasNext()) {
-        QRegularExpressionMatch match = tableIterator.next();
-        QString matchedText = match.captured(0);
-        QString placeholder = QString("__TABLE_%1__").arg(tableMatches.size());
-        tableMatches.append(matchedText);
-        result.replace(matchedText, placeholder);
-    }
-    
-    for (int i = 0; i < tableMatches.size(); ++i) {
-        QString tableText = tableMatches[i];
-        QStringList rows = tableText.split('\n', Qt::SkipEmptyParts);
-        
-        if (rows.size() < 2) {
-            // 不是有效的表格，至少需要标题行和分隔行
-            result.replace(QString("__TABLE_%1__").arg(i), tableText);
-            continue;
-        }
-        
-        // 检查是否有分隔行（第二行）
-        QRegularExpression separatorRegex("^\\|\\s*(:?-+:?\\s*\\|)+\\s*$");
-        if (!separatorRegex.match(rows[1]).hasMatch()) {
-            // 不是有效的表格分隔行
-            result.replace(QString("__TABLE_%1__").arg(i), tableText);
-            continue;
-        }
-        
-        QString htmlTable = "<table>\n";
-        
-        // 处理表头
-        htmlTable += "<thead>\n<tr>\n";
-        QStringList headerCells = rows[0].split('|');
-        // 移除首尾空单元格（如果存在）
-        if (!headerCells.isEmpty() && headerCells.first().trimmed().isEmpty()) {
-            headerCells.removeFirst();
-        }
-        if (!headerCells.isEmpty() && headerCells.last().trimmed().isEmpty()) {
-            headerCells.removeLast();
-        }
-        
-        for (const QString &cell : headerCells) {
-            htmlTable += "<th>" + cell.trimmed() + "</th>\n";
-        }
-        
-        htmlTable += "</tr>\n</thead>\n";
-        
-        // 处理表格内容
-        if (rows.size() > 2) {
-            htmlTable += "<tbody>\n";
-            
-            for (int j = 2; j < rows.size(); ++j) {
-                htmlTable += "<tr>\n";
-                QStringList cells = rows[j].split('|');
-                
-                // 移除首尾空单元格（如果存在）
-                if (!cells.isEmpty() && cells.first().trimmed().isEmpty()) {
-                    cells.removeFirst();
-                }
-                if (!cells.isEmpty() && cells.last().trimmed().isEmpty()) {
-                    cells.removeLast();
-                }
-                
-                for (const QString &cell : cells) {
-                    htmlTable += "<td>" + cell.trimmed() + "</td>\n";
-                }
-                
-                htmlTable += "</tr>\n";
-            }
-            
-            htmlTable += "</tbody>\n";
-        }
-        
-        htmlTable += "</table>";
-        result.replace(QString("__TABLE_%1__").arg(i), htmlTable);
-    }
-    
-    return result;
+    return MarkdownTokenizer::toHtml(markdown, m_images, m_imageBaseDir);
 }
 
 QString MarkdownRenderer::getCustomCss() const
@@ -732,6 +596,55 @@ QString MarkdownRenderer::getCustomCss() const
         .katex-display {
             margin: 10px 0;
         }
+        
+        .choices {
+            margin-top: 12px;
+        }
+        
+        .choice {
+            display: flex;
+            align-items: flex-start;
+            padding: 6px 10px;
+            margin: 6px 0;
+            border: 1px solid #dee2e6;
+            border-radius: 5px;
+            cursor: pointer;
+        }
+        
+        .choice:hover {
+            background-color: #f1f8ff;
+        }
+        
+        .choice.selected {
+            border-color: #007bff;
+            background-color: #e7f1ff;
+        }
+        
+        .choices-disabled .choice {
+            cursor: default;
+        }
+        
+        .choices-disabled .choice:hover {
+            background-color: transparent;
+        }
+        
+        .choices-disabled .choice.selected {
+            background-color: #e7f1ff;
+        }
+        
+        .choice-label {
+            font-weight: bold;
+            min-width: 24px;
+            line-height: 1.6;
+        }
+        
+        .choice-body {
+            flex: 1;
+        }
+        
+        .choice-body p {
+            margin: 0;
+        }
     )";
 }
 
@@ -744,26 +657,163 @@ void MarkdownRenderer::setContent(const QString &markdownText, const QMap<QStrin
 {
     m_images = images;
     m_imageBaseDir = imageBaseDir;
+    m_selectedChoices.clear();
+    m_nativeChoiceLabels.clear();
+    m_nativeChoiceHtml.clear();
+
+    if (m_nativeRendering && isNativeRenderable(markdownText)) {
+        m_nativeQuestionHtml = convertMarkdownToHtml(markdownText);
+        showNativeContent();
+        return;
+    }
+
+    loadContentHtml(convertMarkdownToHtml(markdownText));
+}
+
+void MarkdownRenderer::setQuestionContent(const QString &questionText, const QStringList &choices, const QStringList &labels,
+                                          const QMap<QString, QString> &images, const QString &imageBaseDir)
+{
+    m_images = images;
+    m_imageBaseDir = imageBaseDir;
+    m_selectedChoices.clear();
+    m_nativeChoiceLabels.clear();
+    m_nativeChoiceHtml.clear();
+
+    bool nativeRenderable = m_nativeRendering && isNativeRenderable(questionText);
+    for (int i = 0; nativeRenderable && i < choices.size(); ++i) {
+        nativeRenderable = isNativeRenderable(choices[i]);
+    }
+    if (nativeRenderable) {
+        m_nativeQuestionHtml = convertMarkdownToHtml(questionText);
+        for (int i = 0; i < choices.size() && i < labels.size(); ++i) {
+            m_nativeChoiceLabels.append(labels[i]);
+            m_nativeChoiceHtml.append(convertMarkdownToHtml(choices[i]));
+        }
+        showNativeContent();
+        return;
+    }
+
+    QString htmlContent = convertMarkdownToHtml(questionText);
+    htmlContent += "\n<div class=\"choices\">\n";
+    for (int i = 0; i < choices.size() && i < labels.size(); ++i) {
+        htmlContent += QString("<div class=\"choice\" data-index=\"%1\">"
+                               "<span class=\"choice-label\">%2.</span>"
+                               "<div class=\"choice-body\">%3</div></div>\n")
+                           .arg(i)
+                           .arg(labels[i].toHtmlEscaped(), convertMarkdownToHtml(choices[i]));
+    }
+    htmlContent += "</div>";
+
+    loadContentHtml(htmlContent);
+}
+
+void MarkdownRenderer::setSelectedChoices(const QList<int> &indices)
+{
+    m_selectedChoices = indices;
+    applyChoiceState();
+}
 
-    QString htmlContent = convertMarkdownToHtml(markdownText);
+void MarkdownRenderer::setChoicesEnabled(bool enabled)
+{
+    m_choicesEnabled = enabled;
+    applyChoiceState();
+}
+
+void MarkdownRenderer::applyChoiceState()
+{
+    if (m_backend == Backend::Native) {
+        if (!m_nativeChoiceHtml.isEmpty()) {
+            showNativeContent();
+        }
+        return;
+    }
+    if (!m_webView) {
+        return;
+    }
+    
+    QJsonArray indices;
+    for (int index : m_selectedChoices) {
+        indices.append(index);
+    }
+    const QString script = QString(
+        "if (typeof setSelectedChoices === 'function') { setSelectedChoices(%1); setChoicesEnabled(%2); }")
+        .arg(QString::fromUtf8(QJsonDocument(indices).toJson(QJsonDocument::Compact)),
+             m_choicesEnabled ? "true" : "false");
+    m_webView->page()->runJavaScript(script);
+}
+
+void MarkdownRenderer::loadContentHtml(const QString &htmlContent)
+{
+    switchBackend(Backend::WebEngine);
+    m_currentContent = htmlContent;
+    
+    if (m_inPlaceUpdates) {
+        if (m_pageState == PageState::Ready) {
+            pushContentHtml(htmlContent);
+            return;
+        }
+        if (m_pageState == PageState::Loading) {
+            // 模板还没加载完，只保留最新一次的内容，加载完成后再推送
+            m_pendingContent = htmlContent;
+            m_hasPendingContent = true;
+            return;
+        }
+    }
+    
+    m_hasPendingContent = false;
+    m_pendingContent.clear();
+    m_pageState = PageState::Loading;
+    m_templateLoadRequested = true;
+    
     QString finalHtml = m_htmlTemplate;
-    finalHtml.replace("%CONTENT%", htmlContent);
+    finalHtml.replace("%TYPESET%", needsTypesetting(htmlContent) ? "true" : "false");
+    finalHtml.replace("%CONTENT%", ResourceSchemeHandler::rewriteImageUrls(htmlContent));
     finalHtml.replace("%CUSTOM_CSS%", getCustomCss());
     
-    // 获取应用程序的路径作为baseUrl，以便正确加载相对路径的资源
-    QString appDirPath = QCoreApplication::applicationDirPath();
-    QUrl baseUrl = QUrl::fromLocalFile(appDirPath + "/resources/");
-    m_webView->setHtml(finalHtml, baseUrl);
+    // 相对路径的KaTeX资源通过资源协议从内存加载
+    m_webView->setHtml(finalHtml, ResourceSchemeHandler::resourcesBaseUrl());
+}
+
+bool MarkdownRenderer::needsTypesetting(const QString &htmlContent)
+{
+    // 预渲染的公式不含$定界符，还有$说明存在未预渲染的公式（或普通的美元符号）
+    return htmlContent.contains(QLatin1Char('$'));
+}
+
+void MarkdownRenderer::pushContentHtml(const QString &htmlContent)
+{
+    // 以JSON数组传递内容，由JSON负责引号、换行等字符的转义
+    QJsonArray args;
+    args.append(ResourceSchemeHandler::rewriteImageUrls(htmlContent));
+    args.append(needsTypesetting(htmlContent));
+    const QString script = QString("updateContent.apply(null, %1);")
+        .arg(QString::fromUtf8(QJsonDocument(args).toJson(QJsonDocument::Compact)));
+    
+    // 高度变化由页面通过ResizeObserver上报，这里不再查询
+    m_webView->page()->runJavaScript(script);
+}
+
+void MarkdownRenderer::setInPlaceUpdates(bool enabled)
+{
+    m_inPlaceUpdates = enabled;
 }
 
 void MarkdownRenderer::setMinimumHeight(int height)
 {
-    m_webView->setMinimumHeight(height);
+    m_viewMinimumHeight = height;
+    m_nativeView->setMinimumHeight(height);
+    if (m_webView) {
+        m_webView->setMinimumHeight(height);
+    }
 }
 
 void MarkdownRenderer::setMaximumHeight(int height)
 {
-    m_webView->setMaximumHeight(height);
+    m_viewMaximumHeight = height;
+    m_nativeView->setMaximumHeight(height);
+    if (m_webView) {
+        m_webView->setMaximumHeight(height);
+    }
 }
 
 void MarkdownRenderer::setAutoResize(bool enabled, int maxHeight)
@@ -785,26 +835,107 @@ void MarkdownRenderer::setAutoResize(bool enabled, int maxHeight)
             m_maxAutoHeight = m_parentMaxHeight;
         }
         
-        // 连接页面加载完成信号到调整大小槽
-        connect(m_webView, &QWebEngineView::loadFinished,
-                this, &MarkdownRenderer::adjustSizeToContent, Qt::UniqueConnection);
-    } else {
-        // 断开连接
-        disconnect(m_webView, &QWebEngineView::loadFinished,
-                   this, &MarkdownRenderer::adjustSizeToContent);
+        scheduleAutoHeight();
     }
 }
 
+void MarkdownRenderer::resetForReuse()
+{
+    disconnect(this, &MarkdownRenderer::choiceClicked, nullptr, nullptr);
+    setAutoResize(false);
+    
+    m_selectedChoices.clear();
+    m_choicesEnabled = true;
+    m_images.clear();
+    m_imageBaseDir.clear();
+    m_nativeQuestionHtml.clear();
+    m_nativeChoiceLabels.clear();
+    m_nativeChoiceHtml.clear();
+    m_nativeView->clear();
+    m_currentContent.clear();
+    m_reportedHeight = 0;
+    
+    // 自动适配会设置固定高度，这里恢复为不受限
+    setMinimumHeight(0);
+    setMaximumHeight(QWIDGETSIZE_MAX);
+    QWidget::setMinimumHeight(0);
+    QWidget::setMaximumHeight(QWIDGETSIZE_MAX);
+    setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Preferred);
+    setStyleSheet(QString());
+    setObjectName(QString());
+}
+
 void MarkdownRenderer::setStyleTheme(const QString &theme)
 {
     m_currentTheme = theme;
     // 可以根据主题调整CSS样式
 }
 
+void MarkdownRenderer::onLoadStarted()
+{
+    if (m_templateLoadRequested) {
+        m_templateLoadRequested = false;
+        return;
+    }
+    // 不是模板加载（例如页面脚本跳转），新页面中没有updateContent，下次更新需要重新加载模板
+    m_pageState = PageState::Empty;
+}
+
 void MarkdownRenderer::onLoadFinished(bool success)
 {
+    if (m_pageState != PageState::Loading) {
+        // 模板以外的页面加载完成，保持Empty
+        return;
+    }
+    
     if (!success) {
         qDebug() << "Failed to load content in MarkdownRenderer";
+        m_pageState = PageState::Empty;
+        if (m_hasPendingContent) {
+            // 模板加载失败时退回整页加载
+            const QString pending = m_pendingContent;
+            loadContentHtml(pending);
+        }
+        return;
+    }
+    
+    m_pageState = PageState::Ready;
+    m_recoveringFromCrash = false;
+    if (m_hasPendingContent) {
+        m_hasPendingContent = false;
+        pushContentHtml(m_pendingContent);
+        m_pendingContent.clear();
+    }
+    applyChoiceState();
+}
+
+void MarkdownRenderer::onRenderProcessTerminated(QWebEnginePage::RenderProcessTerminationStatus status, int exitCode)
+{
+    qWarning() << "MarkdownRenderer render process terminated:" << status << exitCode;
+    
+    // 渲染进程退出后页面中的脚本都不存在了，重新加载模板和最近一次的内容，
+    // 选项状态在加载完成后由onLoadFinished同步
+    m_pageState = PageState::Empty;
+    m_templateLoadRequested = false;
+    m_hasPendingContent = false;
+    m_pendingContent.clear();
+    
+    // 恢复后的页面再次崩溃时不再重试，避免同一内容反复导致崩溃
+    if (m_recoveringFromCrash || m_backend != Backend::WebEngine || m_currentContent.isEmpty()) {
+        return;
+    }
+    m_recoveringFromCrash = true;
+    const QString content = m_currentContent;
+    loadContentHtml(content);
+}
+
+void MarkdownRenderer::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+
+    // 隐藏期间的高度变化（如图片加载完成）可能没有上报，显示时让页面再上报一次
+    if (m_autoResize && m_backend == Backend::WebEngine && m_webView && m_pageState == PageState::Ready) {
+        m_webView->page()->runJavaScript("if (typeof reportHeight === 'function') { reportHeight(); }");
     }
 }
 
@@ -812,19 +943,49 @@ void MarkdownRenderer::resizeEvent(QResizeEvent *event)
 {
     QWidget::resizeEvent(event);
 
-    if (!m_autoResize) {
-        return;
+    // 网页内容宽度变化后ResizeObserver会自动上报新高度，只有原生视图需要重新计算
+    if (m_autoResize && m_backend == Backend::Native) {
+        scheduleAutoHeight();
     }
+}
 
-    if (m_resizePending) {
+// 等待应用新高度的渲染器。同一轮事件循环中所有渲染器的高度变化一起应用，
+// 父布局只需要重新计算一次
+static QList<QPointer<MarkdownRenderer>> &pendingHeightUpdates()
+{
+    static QList<QPointer<MarkdownRenderer>> pending;
+    return pending;
+}
+
+void MarkdownRenderer::scheduleAutoHeight()
+{
+    QList<QPointer<MarkdownRenderer>> &pending = pendingHeightUpdates();
+    if (pending.contains(this)) {
         return;
     }
-    m_resizePending = true;
+    if (pending.isEmpty()) {
+        QTimer::singleShot(0, &MarkdownRenderer::flushPendingHeights);
+    }
+    pending.append(this);
+}
 
-    QTimer::singleShot(0, this, [this]() {
-        m_resizePending = false;
-        adjustSizeToContent();
-    });
+void MarkdownRenderer::flushPendingHeights()
+{
+    const QList<QPointer<MarkdownRenderer>> pending = pendingHeightUpdates();
+    pendingHeightUpdates().clear();
+    for (const QPointer<MarkdownRenderer> &renderer : pending) {
+        if (renderer) {
+            renderer->adjustSizeToContent();
+        }
+    }
+}
+
+void MarkdownRenderer::onContentHeightReported(int height)
+{
+    m_reportedHeight = height;
+    if (m_autoResize && m_backend == Backend::WebEngine) {
+        scheduleAutoHeight();
+    }
 }
 
 void MarkdownRenderer::adjustSizeToContent()
@@ -833,175 +994,42 @@ void MarkdownRenderer::adjustSizeToContent()
         return;
     }
     
-    // 使用JavaScript获取内容的实际高度
-    m_webView->page()->runJavaScript(
-        "document.body.scrollHeight;",
-        [this](const QVariant &result) {
-            bool ok;
-            int contentHeight = result.toInt(&ok);
-            if (ok && contentHeight > 0) {
-                // 添加一些边距
-                int targetHeight = contentHeight + 20;
-                
-                // 确保不超过最大高度限制
-                if (m_maxAutoHeight > 0) {
-                    targetHeight = qMin(targetHeight, m_maxAutoHeight);
-                }
-                
-                // 设置最小高度为40像素
-                targetHeight = qMax(targetHeight, 40);
-                
-                // 应用新的高度
-                m_webView->setFixedHeight(targetHeight);
-                setFixedHeight(targetHeight);
-                updateGeometry();
-                if (parentWidget()) {
-                    parentWidget()->updateGeometry();
-                }
-                
-                qDebug() << "Auto-resized MarkdownRenderer to height:" << targetHeight;
-            }
+    if (m_backend == Backend::Native) {
+        // QLabel按当前宽度直接算出高度（已包含内边距），不需要等待页面
+        const int labelWidth = m_nativeView->width() > 0 ? m_nativeView->width() : width();
+        int contentHeight = m_nativeView->heightForWidth(labelWidth);
+        if (contentHeight <= 0) {
+            contentHeight = m_nativeView->sizeHint().height();
         }
-    );
-}
-
-QString MarkdownRenderer::protectSpecialContent(const QString &html)
-{
-    QString result = html;
-    
-    // 存储需要保护的内容
-    QStringList protectedBlocks;
-    QStringList placeholders;
-    
-    // 保护代码块 - 使用原始markdown语法
-    QRegularExpression codeBlockRegex("```[^\\r\\n]*\\R?[\\s\\S]*?```", QRegularExpression::DotMatchesEverythingOption);
-    QRegularExpressionMatchIterator codeIterator = codeBlockRegex.globalMatch(result);
-    QList<QRegularExpressionMatch> codeMatches;
-    while (codeIterator.hasNext()) {
-        codeMatches.append(codeIterator.next());
-    }
-    // 从后往前替换，避免位置偏移
-    for (int i = codeMatches.size() - 1; i >= 0; --i) {
-        QRegularExpressionMatch match = codeMatches[i];
-        QString placeholder = QString("__PROTECTED_CODE_%1__").arg(protectedBlocks.size());
-        protectedBlocks.append(match.captured(0));
-        placeholders.append(placeholder);
-        result.replace(match.capturedStart(), match.capturedLength(), placeholder);
-    }
-    
-    // 保护行内代码
-    QRegularExpression inlineCodeRegex("`([^`]+)`");
-    QRegularExpressionMatchIterator inlineCodeIterator = inlineCodeRegex.globalMatch(result);
-    QList<QRegularExpressionMatch> inlineCodeMatches;
-    while (inlineCodeIterator.hasNext()) {
-        inlineCodeMatches.append(inlineCodeIterator.next());
-    }
-    // 从后往前替换，避免位置偏移
-    for (int i = inlineCodeMatches.size() - 1; i >= 0; --i) {
-        QRegularExpressionMatch match = inlineCodeMatches[i];
-        QString placeholder = QString("__PROTECTED_INLINE_CODE_%1__").arg(protectedBlocks.size());
-        protectedBlocks.append(match.captured(0));
-        placeholders.append(placeholder);
-        result.replace(match.capturedStart(), match.capturedLength(), placeholder);
-    }
-    
-    // 保护双美元符号LaTeX公式
-    QRegularExpression latexBlockRegex("\\$\\$([^$]*?)\\$\\$", QRegularExpression::DotMatchesEverythingOption);
-    QRegularExpressionMatchIterator latexBlockIterator = latexBlockRegex.globalMatch(result);
-    QList<QRegularExpressionMatch> latexBlockMatches;
-    while (latexBlockIterator.hasNext()) {
-        latexBlockMatches.append(latexBlockIterator.next());
-    }
-    // 从后往前替换，避免位置偏移
-    for (int i = latexBlockMatches.size() - 1; i >= 0; --i) {
-        QRegularExpressionMatch match = latexBlockMatches[i];
-        // 获取原始内容并进行特殊处理
-        QString latexContent = match.captured(0);
-        // 使用HTML实体编码替换<和>，确保它们在LaTeX处理时被正确解释
-        latexContent.replace("<", "&lt;");
-        latexContent.replace(">", "&gt;");
-        QString placeholder = QString("__PROTECTED_LATEX_BLOCK_%1__").arg(protectedBlocks.size());
-        protectedBlocks.append(latexContent);
-        placeholders.append(placeholder);
-        result.replace(match.capturedStart(), match.capturedLength(), placeholder);
-    }
-    
-    // 保护单美元符号LaTeX公式
-    QRegularExpression latexInlineRegex("\\$([^$]+?)\\$");
-    QRegularExpressionMatchIterator latexInlineIterator = latexInlineRegex.globalMatch(result);
-    QList<QRegularExpressionMatch> latexInlineMatches;
-    while (latexInlineIterator.hasNext()) {
-        latexInlineMatches.append(latexInlineIterator.next());
-    }
-    // 从后往前替换，避免位置偏移
-    for (int i = latexInlineMatches.size() - 1; i >= 0; --i) {
-        QRegularExpressionMatch match = latexInlineMatches[i];
-        // 获取原始内容并进行特殊处理
-        QString latexContent = match.captured(0);
-        // 使用HTML实体编码替换<和>，确保它们在LaTeX处理时被正确解释
-        latexContent.replace("<", "&lt;");
-        latexContent.replace(">", "&gt;");
-        QString placeholder = QString("__PROTECTED_LATEX_INLINE_%1__").arg(protectedBlocks.size());
-        protectedBlocks.append(latexContent);
-        placeholders.append(placeholder);
-        result.replace(match.capturedStart(), match.capturedLength(), placeholder);
-    }
-    
-    // 保护引用块
-    QRegularExpression quoteRegex("^> (.+)$", QRegularExpression::MultilineOption);
-    QRegularExpressionMatchIterator quoteIterator = quoteRegex.globalMatch(result);
-    QList<QRegularExpressionMatch> quoteMatches;
-    while (quoteIterator.hasNext()) {
-        quoteMatches.append(quoteIterator.next());
-    }
-    // 从后往前替换，避免位置偏移
-    for (int i = quoteMatches.size() - 1; i >= 0; --i) {
-        QRegularExpressionMatch match = quoteMatches[i];
-        QString placeholder = QString("__PROTECTED_QUOTE_%1__").arg(protectedBlocks.size());
-        protectedBlocks.append(match.captured(0));
-        placeholders.append(placeholder);
-        result.replace(match.capturedStart(), match.capturedLength(), placeholder);
-    }
-    
-    // 将保护信息存储到成员变量中，供后续恢复使用
-    m_protectedBlocks = protectedBlocks;
-    m_placeholders = placeholders;
+        applyAutoHeight(contentHeight);
+        return;
+    }
     
-    return result;
+    // 使用页面最近一次上报的内容高度，并添加一些边距
+    if (m_reportedHeight > 0) {
+        applyAutoHeight(m_reportedHeight + 20);
+    }
 }
 
-QString MarkdownRenderer::restoreAndProcessProtectedContent(const QString &html)
+void MarkdownRenderer::applyAutoHeight(int targetHeight)
 {
-    QString result = html;
-    
-    // 恢复并处理被保护的内容
-    for (int i = 0; i < m_protectedBlocks.size(); ++i) {
-        QString content = m_protectedBlocks[i];
-        QString placeholder = m_placeholders[i];
-        
-        if (placeholder.startsWith("__PROTECTED_CODE_")) {
-            // 处理代码块
-            content = processCodeBlocks(content);
-        } else if (placeholder.startsWith("__PROTECTED_INLINE_CODE_")) {
-            // 处理行内代码
-            QRegularExpression inlineCodeRegex("`([^`]+)`");
-            content.replace(inlineCodeRegex, "<code>\\1</code>");
-        } else if (placeholder.startsWith("__PROTECTED_LATEX_BLOCK_")) {
-            // 处理LaTeX块公式 - 直接使用原始内容，不需要额外处理
-        } else if (placeholder.startsWith("__PROTECTED_LATEX_INLINE_")) {
-            // 处理LaTeX行内公式 - 直接使用原始内容，不需要额外处理
-        } else if (placeholder.startsWith("__PROTECTED_QUOTE_")) {
-            // 处理引用块
-            QRegularExpression quoteRegex("^> (.+)$", QRegularExpression::MultilineOption);
-            content.replace(quoteRegex, "<blockquote>\\1</blockquote>");
-        }
-        
-        result.replace(placeholder, content);
+    // 确保不超过最大高度限制
+    if (m_maxAutoHeight > 0) {
+        targetHeight = qMin(targetHeight, m_maxAutoHeight);
     }
     
-    // 清理保护信息
-    m_protectedBlocks.clear();
-    m_placeholders.clear();
+    // 设置最小高度为40像素
+    targetHeight = qMax(targetHeight, 40);
     
-    return result;
+    // 应用新的高度
+    if (m_webView) {
+        m_webView->setFixedHeight(targetHeight);
+    }
+    setFixedHeight(targetHeight);
+    updateGeometry();
+    if (parentWidget()) {
+        parentWidget()->updateGeometry();
+    }
+    
+    qDebug() << "Auto-resized MarkdownRenderer to height:" << targetHeight;
 }
@@ -3,12 +3,47 @@
 
 #include <QWidget>
 #include <QWebEngineView>
+#include <QWebEnginePage>
 #include <QVBoxLayout>
 #include <QString>
 #include <QUrl>
 #include <QDir>
 #include <QStandardPaths>
 #include <QMap>
+#include <QList>
+
+class QWebChannel;
+class QLabel;
+
+// 通过QWebChannel暴露给页面脚本的桥接对象，只包含页面需要调用的方法
+class MarkdownRendererBridge : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MarkdownRendererBridge(QObject *parent = nullptr) : QObject(parent) {}
+
+public slots:
+    void choiceClicked(int index) { emit choiceActivated(index); }
+    void reportContentHeight(int height) { emit contentHeightChanged(height); }
+
+signals:
+    void choiceActivated(int index);
+    void contentHeightChanged(int height);
+};
+
+// 渲染器使用的页面：题目内容中的链接用系统浏览器打开，页面本身不离开模板
+class MarkdownRendererPage : public QWebEnginePage
+{
+    Q_OBJECT
+
+public:
+    MarkdownRendererPage(QWebEngineProfile *profile, QObject *parent = nullptr)
+        : QWebEnginePage(profile, parent) {}
+
+protected:
+    bool acceptNavigationRequest(const QUrl &url, NavigationType type, bool isMainFrame) override;
+};
 
 class MarkdownRenderer : public QWidget
 {
@@ -20,6 +55,12 @@ public:
     
     void setContent(const QString &markdownText);
     void setContent(const QString &markdownText, const QMap<QString, QString> &images, const QString &imageBaseDir = QString());
+    
+    // 将题干和全部选项渲染到同一个页面中，点击选项通过choiceClicked信号通知
+    void setQuestionContent(const QString &questionText, const QStringList &choices, const QStringList &labels,
+                            const QMap<QString, QString> &images, const QString &imageBaseDir = QString());
+    void setSelectedChoices(const QList<int> &indices);
+    void setChoicesEnabled(bool enabled);
     void setMinimumHeight(int height);
     void setMaximumHeight(int height);
     
@@ -29,28 +70,66 @@ public:
     // 设置样式主题
     void setStyleTheme(const QString &theme = "default");
     
+    // 原生渲染：不含公式、表格和代码的内容用QLabel显示，不创建WebEngine页面（默认开启）
+    void setNativeRendering(bool enabled);
+    bool isUsingNativeRendering() const { return m_backend == Backend::Native; }
+    
+    // 提前创建WebEngine视图（原生渲染时WebEngine视图按需创建）
+    void warmUpWebEngine();
+    
+    // 原地更新模式：模板只加载一次，之后通过runJavaScript替换内容（默认开启）
+    void setInPlaceUpdates(bool enabled);
+    
+    // 已转换HTML缓存（所有渲染器共享），容量按字符数计算
+    static void setHtmlCacheCapacity(int maxChars);
+    static void clearHtmlCache();
+    
+    // 归还对象池前清除与上一个使用者相关的状态（信号连接、尺寸约束、样式等）
+    void resetForReuse();
+    
+    void showEvent(QShowEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
 
+signals:
+    void choiceClicked(int index);
+
 private slots:
+    void onLoadStarted();
     void onLoadFinished(bool success);
+    void onRenderProcessTerminated(QWebEnginePage::RenderProcessTerminationStatus status, int exitCode);
     void adjustSizeToContent();
+    void onNativeLinkActivated(const QString &link);
+    void onContentHeightReported(int height);
     
 private:
+    enum class Backend {
+        Native,     // QLabel富文本
+        WebEngine   // QWebEngineView + KaTeX
+    };
+    
+    void setupNativeView();
     void setupWebEngine();
+    void switchBackend(Backend backend);
+    static bool isNativeRenderable(const QString &markdown);
+    void showNativeContent();
+    QString constrainNativeImages(const QString &html) const;
+    void applyAutoHeight(int targetHeight);
+    void scheduleAutoHeight();
+    static void flushPendingHeights();
     void createHtmlTemplate();
     QString convertMarkdownToHtml(const QString &markdown);
-    QString protectSpecialContent(const QString &html);
-    QString restoreAndProcessProtectedContent(const QString &html);
-    QString processCodeBlocks(const QString &html);
-    QString processLatexBlocks(const QString &html);
-    QString escapeHtmlSpecialChars(const QString &html);
-    QString processParagraphs(const QString &html);
-    QString processLists(const QString &html);
-    QString processTables(const QString &html);
+    QString renderMarkdownToHtml(const QString &markdown);
     QString getKatexHtml() const;
     QString getCustomCss() const;
+    void loadContentHtml(const QString &htmlContent);
+    void pushContentHtml(const QString &htmlContent);
+    static bool needsTypesetting(const QString &htmlContent);
+    void applyChoiceState();
     
-    QWebEngineView *m_webView;
+    QWebEngineView *m_webView;  // 按需创建，可能为空
+    QLabel *m_nativeView;
+    QWebChannel *m_webChannel;
+    MarkdownRendererBridge *m_bridge;
     QVBoxLayout *m_layout;
     QString m_htmlTemplate;
     QString m_currentTheme;
@@ -60,14 +139,37 @@ private:
     int m_maxAutoHeight;
     int m_parentMaxHeight;
     
-    // 用于保护特殊内容的成员变量
-    QStringList m_protectedBlocks;
-    QStringList m_placeholders;
-
     QMap<QString, QString> m_images;
     QString m_imageBaseDir;
 
-    bool m_resizePending;
+    int m_reportedHeight;   // 页面最近一次上报的内容高度
+
+    // 页面内选项的选中/可用状态，页面重新加载后需要再次同步
+    QList<int> m_selectedChoices;
+    bool m_choicesEnabled;
+
+    // 原地更新相关状态
+    enum class PageState {
+        Empty,      // 尚未加载模板
+        Loading,    // 模板加载中，新内容暂存到m_pendingContent
+        Ready       // 模板已就绪，可以直接替换内容
+    };
+    bool m_inPlaceUpdates;
+    PageState m_pageState;
+    bool m_templateLoadRequested;   // 下一次loadStarted来自loadContentHtml
+    QString m_currentContent;       // 最近一次要求显示的内容，渲染进程崩溃后据此恢复
+    bool m_recoveringFromCrash;
+    QString m_pendingContent;
+    bool m_hasPendingContent;
+
+    // 原生渲染相关状态，选中状态变化时据此重新生成富文本
+    bool m_nativeRendering;
+    Backend m_backend;
+    QString m_nativeQuestionHtml;
+    QStringList m_nativeChoiceLabels;
+    QStringList m_nativeChoiceHtml;
+    int m_viewMinimumHeight;
+    int m_viewMaximumHeight;
 };
 
 #endif // MARKDOWNRENDERER_H
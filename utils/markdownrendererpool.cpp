@@ -0,0 +1,105 @@
+#include "markdownrendererpool.h"
+#include "markdownrenderer.h"
+#include <QCoreApplication>
+
+MarkdownRendererPool *MarkdownRendererPool::instance()
+{
+    static QPointer<MarkdownRendererPool> pool;
+    if (!pool) {
+        pool = new MarkdownRendererPool(QCoreApplication::instance());
+    }
+    return pool;
+}
+
+MarkdownRendererPool::MarkdownRendererPool(QObject *parent)
+    : QObject(parent)
+    , m_capacity(6)
+{
+    // 空闲渲染器没有父窗口，必须在QApplication析构之前释放
+    if (QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+                this, &MarkdownRendererPool::clear);
+    }
+}
+
+MarkdownRenderer *MarkdownRendererPool::acquire(QWidget *parent)
+{
+    while (!m_idle.isEmpty()) {
+        QPointer<MarkdownRenderer> renderer = m_idle.takeFirst();
+        if (renderer) {
+            // setParent会隐藏窗口，有父窗口时需要重新显示（父窗口可见时才会真正显示）
+            renderer->setParent(parent);
+            if (parent) {
+                renderer->show();
+            }
+            return renderer;
+        }
+    }
+
+    return new MarkdownRenderer(parent);
+}
+
+void MarkdownRendererPool::release(MarkdownRenderer *renderer)
+{
+    if (!renderer) {
+        return;
+    }
+
+    if (m_capacity <= 0) {
+        renderer->deleteLater();
+        return;
+    }
+
+    renderer->resetForReuse();
+    renderer->hide();
+    renderer->setParent(nullptr);
+    m_idle.prepend(renderer);
+    evictOverflow();
+}
+
+void MarkdownRendererPool::prewarm(int count)
+{
+    const int target = qMin(count, m_capacity);
+    while (idleCount() < target) {
+        // 渲染器默认原生显示，WebEngine视图按需创建；预热的目的就是提前创建视图
+        MarkdownRenderer *renderer = new MarkdownRenderer();
+        renderer->hide();
+        renderer->warmUpWebEngine();
+        m_idle.append(renderer);
+    }
+}
+
+void MarkdownRendererPool::setCapacity(int capacity)
+{
+    m_capacity = qMax(0, capacity);
+    evictOverflow();
+}
+
+int MarkdownRendererPool::idleCount() const
+{
+    int count = 0;
+    for (const QPointer<MarkdownRenderer> &renderer : m_idle) {
+        if (renderer) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void MarkdownRendererPool::clear()
+{
+    for (const QPointer<MarkdownRenderer> &renderer : m_idle) {
+        delete renderer.data();
+    }
+    m_idle.clear();
+}
+
+void MarkdownRendererPool::evictOverflow()
+{
+    while (m_idle.size() > m_capacity) {
+        QPointer<MarkdownRenderer> renderer = m_idle.takeLast();
+        if (renderer) {
+            renderer->deleteLater();
+        }
+    }
+}
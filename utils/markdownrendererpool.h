@@ -0,0 +1,63 @@
+#ifndef MARKDOWNRENDERERPOOL_H
+#define MARKDOWNRENDERERPOOL_H
+
+#include <QObject>
+#include <QList>
+#include <QPointer>
+
+class QWidget;
+class MarkdownRenderer;
+
+/**
+ * @brief MarkdownRenderer对象池
+ *
+ * 创建QWebEngineView是界面中最耗时的操作。对象池保存已经初始化好的渲染器，
+ * 各界面取用后设置新内容即可，不再用完就销毁、下次重新创建。
+ * 空闲渲染器超过容量时按最久未使用的顺序淘汰。
+ */
+class MarkdownRendererPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    static MarkdownRendererPool *instance();
+
+    /**
+     * @brief 取出一个渲染器，没有空闲渲染器时新建
+     * @param parent 新的父窗口
+     * @return 渲染器（调用方负责设置内容）
+     */
+    MarkdownRenderer *acquire(QWidget *parent = nullptr);
+
+    /**
+     * @brief 归还渲染器，重置状态后放入空闲列表
+     * @param renderer 渲染器
+     */
+    void release(MarkdownRenderer *renderer);
+
+    /**
+     * @brief 预先创建空闲渲染器（不超过容量），同时创建其中的WebEngine视图
+     * @param count 期望的空闲数量
+     */
+    void prewarm(int count);
+
+    /**
+     * @brief 设置空闲渲染器的最大数量，为0时不缓存
+     * @param capacity 容量
+     */
+    void setCapacity(int capacity);
+    int capacity() const { return m_capacity; }
+    int idleCount() const;
+
+    void clear();
+
+private:
+    explicit MarkdownRendererPool(QObject *parent = nullptr);
+    void evictOverflow();
+
+    // 最近归还的排在最前面，淘汰从末尾开始
+    QList<QPointer<MarkdownRenderer>> m_idle;
+    int m_capacity;
+};
+
+#endif // MARKDOWNRENDERERPOOL_H
@@ -0,0 +1,723 @@
+#include "markdowntokenizer.h"
+#include "mathprerenderer.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QStringList>
+#include <QVector>
+
+// 占位符格式：U+E000 + 旁表下标 + U+E001（私有区字符，正常文本中不会出现）
+static const QChar kSpanBegin(0xE000);
+static const QChar kSpanEnd(0xE001);
+
+struct ProtectedSpan
+{
+    enum Kind {
+        CodeBlock,      // ```...```
+        InlineCode,     // `...`
+        MathBlock,      // $$...$$
+        MathInline      // $...$
+    };
+
+    Kind kind;
+    QString raw;        // 原始文本（包含定界符）
+};
+
+struct InlineContext
+{
+    const QVector<ProtectedSpan> &spans;
+    const QMap<QString, QString> &images;
+    const QString &imageBaseDir;
+};
+
+// 在[from, end)中查找标记，调用方的from单调递增时复用上次的结果：
+// 上次找到的位置仍在from之后就直接返回，上次没找到则之后也不会再有。
+// 这样同一个标记在一次扫描中最多被完整查找一遍。
+class ForwardFinder
+{
+public:
+    explicit ForwardFinder(QLatin1String needle) : m_needle(needle), m_cached(-2) {}
+
+    int find(const QString &text, int from, int end)
+    {
+        if (m_cached == -1 || m_cached >= from) {
+            return m_cached;
+        }
+
+        const int length = m_needle.size();
+        for (int i = from; i + length <= end; ++i) {
+            if (matchesAt(text, i, m_needle)) {
+                m_cached = i;
+                return i;
+            }
+        }
+        m_cached = -1;
+        return -1;
+    }
+
+    static bool matchesAt(const QString &text, int pos, QLatin1String needle)
+    {
+        if (pos < 0 || pos + needle.size() > text.size()) {
+            return false;
+        }
+        for (int j = 0; j < needle.size(); ++j) {
+            if (text.at(pos + j) != QLatin1Char(needle.at(j))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    QLatin1String m_needle;
+    int m_cached;           // -2: 尚未查找；-1: 之后没有该标记
+};
+
+static void appendSpanMarker(QString &text, int index)
+{
+    text += kSpanBegin;
+    text += QString::number(index);
+    text += kSpanEnd;
+}
+
+// 第一步：取出代码块、行内代码和公式，原位置留下占位符
+// 从左到右一次扫描，先出现的定界符优先
+static QString extractProtectedSpans(const QString &source, QVector<ProtectedSpan> &spans)
+{
+    QString text;
+    text.reserve(source.size());
+
+    ForwardFinder fence(QLatin1String("```"));
+    ForwardFinder backtick(QLatin1String("`"));
+    ForwardFinder dollar(QLatin1String("$"));
+    ForwardFinder newline(QLatin1String("\n"));
+
+    const int n = source.size();
+    int i = 0;
+    while (i < n) {
+        const QChar c = source.at(i);
+
+        if (c == QLatin1Char('`')) {
+            if (ForwardFinder::matchesAt(source, i, QLatin1String("```"))) {
+                const int close = fence.find(source, i + 3, n);
+                if (close >= 0) {
+                    appendSpanMarker(text, spans.size());
+                    spans.append(ProtectedSpan{ProtectedSpan::CodeBlock, source.mid(i, close + 3 - i)});
+                    i = close + 3;
+                    continue;
+                }
+            }
+
+            // 行内代码内容不能为空，紧跟的反引号按普通字符处理
+            const int close = backtick.find(source, i + 1, n);
+            if (close > i + 1) {
+                appendSpanMarker(text, spans.size());
+                spans.append(ProtectedSpan{ProtectedSpan::InlineCode, source.mid(i, close + 1 - i)});
+                i = close + 1;
+                continue;
+            }
+        } else if (c == QLatin1Char('$')) {
+            if (i + 1 < n && source.at(i + 1) == QLatin1Char('$')) {
+                // 块公式内容不含$，因此下一个$必须是结束的$$
+                const int close = dollar.find(source, i + 2, n);
+                if (close >= 0 && close + 1 < n && source.at(close + 1) == QLatin1Char('$')) {
+                    appendSpanMarker(text, spans.size());
+                    spans.append(ProtectedSpan{ProtectedSpan::MathBlock, source.mid(i, close + 2 - i)});
+                    i = close + 2;
+                    continue;
+                }
+            } else {
+                // 行内公式不跨行，不同行上的两个美元金额不会被当成一个公式
+                const int close = dollar.find(source, i + 1, n);
+                const int lineEnd = newline.find(source, i + 1, n);
+                if (close > i + 1 && (lineEnd < 0 || lineEnd > close)) {
+                    appendSpanMarker(text, spans.size());
+                    spans.append(ProtectedSpan{ProtectedSpan::MathInline, source.mid(i, close + 1 - i)});
+                    i = close + 1;
+                    continue;
+                }
+            }
+        } else if (c == kSpanBegin) {
+            // 原文中的占位符字符会干扰还原，替换掉
+            text += QChar(QChar::ReplacementCharacter);
+            ++i;
+            continue;
+        }
+
+        text += c;
+        ++i;
+    }
+
+    return text;
+}
+
+static bool isCodeLanguage(const QString &info)
+{
+    if (info.isEmpty() || info.size() > 20) {
+        return false;
+    }
+    const QChar first = info.at(0);
+    if (!((first >= QLatin1Char('A') && first <= QLatin1Char('Z')) ||
+          (first >= QLatin1Char('a') && first <= QLatin1Char('z')))) {
+        return false;
+    }
+    for (int i = 1; i < info.size(); ++i) {
+        const QChar c = info.at(i);
+        const bool allowed = (c >= QLatin1Char('A') && c <= QLatin1Char('Z')) ||
+                             (c >= QLatin1Char('a') && c <= QLatin1Char('z')) ||
+                             (c >= QLatin1Char('0') && c <= QLatin1Char('9')) ||
+                             c == QLatin1Char('_') || c == QLatin1Char('+') || c == QLatin1Char('-');
+        if (!allowed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 代码块：第一行是语言标识时作为class输出，否则第一行也属于代码
+static QString renderCodeBlock(const QString &raw)
+{
+    const QString inner = raw.mid(3, raw.size() - 6);
+    const int newline = inner.indexOf(QLatin1Char('\n'));
+    const QString fenceInfo = newline >= 0 ? inner.left(newline) : inner;
+    const QString body = newline >= 0 ? inner.mid(newline + 1) : QString();
+
+    QString language;
+    QString code;
+    const QString trimmedFenceInfo = fenceInfo.trimmed();
+    if (isCodeLanguage(trimmedFenceInfo)) {
+        language = trimmedFenceInfo;
+        code = body;
+    } else {
+        code = fenceInfo.startsWith(QLatin1Char(' ')) ? fenceInfo.mid(1) : fenceInfo;
+        if (!body.isEmpty()) {
+            if (!code.isEmpty()) {
+                code += QLatin1Char('\n');
+            }
+            code += body;
+        }
+    }
+    if (code.endsWith(QLatin1Char('\n'))) {
+        code.chop(1);
+    }
+
+    if (!language.isEmpty()) {
+        return QString("<pre><code class=\"language-%1\">%2</code></pre>").arg(language, code.toHtmlEscaped());
+    }
+    return QString("<pre><code>%1</code></pre>").arg(code.toHtmlEscaped());
+}
+
+static QString renderSpan(const ProtectedSpan &span)
+{
+    switch (span.kind) {
+    case ProtectedSpan::CodeBlock:
+        return renderCodeBlock(span.raw);
+    case ProtectedSpan::InlineCode:
+        return "<code>" + span.raw.mid(1, span.raw.size() - 2).toHtmlEscaped() + "</code>";
+    case ProtectedSpan::MathBlock:
+    case ProtectedSpan::MathInline: {
+        // 优先使用预渲染的KaTeX结果；没有时保留定界符交给页面排版，只做HTML转义
+        const QString prerendered = MathPrerenderer::cachedHtml(span.raw);
+        if (!prerendered.isNull()) {
+            return prerendered;
+        }
+        return span.raw.toHtmlEscaped();
+    }
+    }
+    return QString();
+}
+
+// 解析pos处的占位符，成功时返回旁表下标并通过next返回占位符之后的位置
+static int parseSpanMarker(const QString &text, int pos, int end, int &next)
+{
+    int j = pos + 1;
+    int index = 0;
+    while (j < end && text.at(j).isDigit()) {
+        index = index * 10 + text.at(j).digitValue();
+        ++j;
+    }
+    if (j == pos + 1 || j >= end || text.at(j) != kSpanEnd) {
+        return -1;
+    }
+    next = j + 1;
+    return index;
+}
+
+// 占位符还原为原始文本，用于图片和链接地址等不做格式处理的部分
+static QString plainText(const InlineContext &ctx, const QString &text, int begin, int end)
+{
+    QString result;
+    result.reserve(end - begin);
+    int i = begin;
+    while (i < end) {
+        if (text.at(i) == kSpanBegin) {
+            int next = i;
+            const int index = parseSpanMarker(text, i, end, next);
+            if (index >= 0 && index < ctx.spans.size()) {
+                result += ctx.spans.at(index).raw;
+                i = next;
+                continue;
+            }
+        }
+        result += text.at(i);
+        ++i;
+    }
+    return result;
+}
+
+// 行内元素发射器：单遍扫描[begin, end)，强调类标记与最近的闭合标记配对，
+// 内部内容递归处理（同类标记不会嵌套，递归深度受标记种类限制）
+static void appendInline(const InlineContext &ctx, const QString &text, int begin, int end, QString &out)
+{
+    ForwardFinder tripleStar(QLatin1String("***"));
+    ForwardFinder doubleStar(QLatin1String("**"));
+    ForwardFinder star(QLatin1String("*"));
+    ForwardFinder doubleTilde(QLatin1String("~~"));
+    ForwardFinder closeBracket(QLatin1String("]"));
+    ForwardFinder closeParen(QLatin1String(")"));
+
+    int i = begin;
+    while (i < end) {
+        const QChar c = text.at(i);
+
+        if (c == kSpanBegin) {
+            int next = i;
+            const int index = parseSpanMarker(text, i, end, next);
+            if (index >= 0 && index < ctx.spans.size()) {
+                out += renderSpan(ctx.spans.at(index));
+                i = next;
+                continue;
+            }
+        } else if (c == QLatin1Char('*')) {
+            if (ForwardFinder::matchesAt(text, i, QLatin1String("***"))) {
+                const int close = tripleStar.find(text, i + 4, end);
+                if (close >= 0) {
+                    out += "<strong><em>";
+                    appendInline(ctx, text, i + 3, close, out);
+                    out += "</em></strong>";
+                    i = close + 3;
+                    continue;
+                }
+            }
+            if (ForwardFinder::matchesAt(text, i, QLatin1String("**"))) {
+                const int close = doubleStar.find(text, i + 3, end);
+                if (close >= 0) {
+                    out += "<strong>";
+                    appendInline(ctx, text, i + 2, close, out);
+                    out += "</strong>";
+                    i = close + 2;
+                    continue;
+                }
+            }
+            const int close = star.find(text, i + 2, end);
+            if (close >= 0) {
+                out += "<em>";
+                appendInline(ctx, text, i + 1, close, out);
+                out += "</em>";
+                i = close + 1;
+                continue;
+            }
+        } else if (c == QLatin1Char('~') && ForwardFinder::matchesAt(text, i, QLatin1String("~~"))) {
+            const int close = doubleTilde.find(text, i + 3, end);
+            if (close >= 0) {
+                out += "<del>";
+                appendInline(ctx, text, i + 2, close, out);
+                out += "</del>";
+                i = close + 2;
+                continue;
+            }
+        } else if (c == QLatin1Char('!') && i + 1 < end && text.at(i + 1) == QLatin1Char('[')) {
+            // 图片 ![alt](src)
+            const int bracket = closeBracket.find(text, i + 2, end);
+            if (bracket >= 0 && bracket + 1 < end && text.at(bracket + 1) == QLatin1Char('(')) {
+                const int paren = closeParen.find(text, bracket + 2, end);
+                if (paren > bracket + 2) {
+                    const QString altText = plainText(ctx, text, i + 2, bracket);
+                    const QString rawSrc = plainText(ctx, text, bracket + 2, paren).trimmed();
+                    const QUrl url = MarkdownTokenizer::resolveImageUrl(rawSrc, ctx.images, ctx.imageBaseDir);
+                    out += QString("<img src=\"%1\" alt=\"%2\" />")
+                        .arg(url.toString().toHtmlEscaped(), altText.toHtmlEscaped());
+                    i = paren + 1;
+                    continue;
+                }
+            }
+        } else if (c == QLatin1Char('[') && !(i > 0 && text.at(i - 1) == QLatin1Char('!'))) {
+            // 链接 [text](url)
+            const int bracket = closeBracket.find(text, i + 1, end);
+            if (bracket > i + 1 && bracket + 1 < end && text.at(bracket + 1) == QLatin1Char('(')) {
+                const int paren = closeParen.find(text, bracket + 2, end);
+                if (paren > bracket + 2) {
+                    out += "<a href=\"" + plainText(ctx, text, bracket + 2, paren).toHtmlEscaped() + "\">";
+                    appendInline(ctx, text, i + 1, bracket, out);
+                    out += "</a>";
+                    i = paren + 1;
+                    continue;
+                }
+            }
+        }
+
+        switch (c.unicode()) {
+        case '&': out += "&amp;"; break;
+        case '<': out += "&lt;"; break;
+        case '>': out += "&gt;"; break;
+        case '"': out += "&quot;"; break;
+        default: out += c; break;
+        }
+        ++i;
+    }
+}
+
+static QString renderInline(const InlineContext &ctx, const QString &text, int begin, int end)
+{
+    QString out;
+    out.reserve(end - begin + 16);
+    appendInline(ctx, text, begin, end, out);
+    return out;
+}
+
+static QString renderInline(const InlineContext &ctx, const QString &text)
+{
+    return renderInline(ctx, text, 0, text.size());
+}
+
+static int leadingWhitespace(const QString &line)
+{
+    int count = 0;
+    while (count < line.size() && line.at(count).isSpace()) {
+        ++count;
+    }
+    return count;
+}
+
+static bool isTableRow(const QString &line)
+{
+    return line.size() >= 3 && line.startsWith(QLatin1Char('|')) && line.endsWith(QLatin1Char('|'));
+}
+
+// 表格分隔行：|---|:---:|，竖线两侧允许空白
+static bool isTableSeparator(const QString &line)
+{
+    const int n = line.size();
+    int pos = 1;
+    int columns = 0;
+    while (true) {
+        while (pos < n && line.at(pos).isSpace()) {
+            ++pos;
+        }
+        if (pos >= n) {
+            break;
+        }
+        if (line.at(pos) == QLatin1Char(':')) {
+            ++pos;
+        }
+        const int dashStart = pos;
+        while (pos < n && line.at(pos) == QLatin1Char('-')) {
+            ++pos;
+        }
+        if (pos == dashStart) {
+            return false;
+        }
+        if (pos < n && line.at(pos) == QLatin1Char(':')) {
+            ++pos;
+        }
+        while (pos < n && line.at(pos).isSpace()) {
+            ++pos;
+        }
+        if (pos >= n || line.at(pos) != QLatin1Char('|')) {
+            return false;
+        }
+        ++pos;
+        ++columns;
+    }
+    return columns > 0;
+}
+
+static QStringList splitTableRow(const QString &row)
+{
+    QStringList cells = row.split(QLatin1Char('|'));
+    if (!cells.isEmpty() && cells.first().trimmed().isEmpty()) {
+        cells.removeFirst();
+    }
+    if (!cells.isEmpty() && cells.last().trimmed().isEmpty()) {
+        cells.removeLast();
+    }
+    return cells;
+}
+
+static QString renderTable(const InlineContext &ctx, const QStringList &lines, int first, int last)
+{
+    QString html = "<table>\n<thead>\n<tr>\n";
+    for (const QString &cell : splitTableRow(lines.at(first))) {
+        html += "<th>" + renderInline(ctx, cell.trimmed()) + "</th>\n";
+    }
+    html += "</tr>\n</thead>\n";
+
+    if (last - first > 2) {
+        html += "<tbody>\n";
+        for (int row = first + 2; row < last; ++row) {
+            html += "<tr>\n";
+            for (const QString &cell : splitTableRow(lines.at(row))) {
+                html += "<td>" + renderInline(ctx, cell.trimmed()) + "</td>\n";
+            }
+            html += "</tr>\n";
+        }
+        html += "</tbody>\n";
+    }
+
+    html += "</table>";
+    return html;
+}
+
+static int headingLevel(const QString &line)
+{
+    int level = 0;
+    while (level < line.size() && level < 7 && line.at(level) == QLatin1Char('#')) {
+        ++level;
+    }
+    if (level == 0 || level > 6 || level + 1 >= line.size() || line.at(level) != QLatin1Char(' ')) {
+        return 0;
+    }
+    return level;
+}
+
+static bool isHorizontalRule(const QString &line)
+{
+    if (line.size() < 3 || (line.at(0) != QLatin1Char('-') && line.at(0) != QLatin1Char('*'))) {
+        return false;
+    }
+    for (const QChar c : line) {
+        if (c != line.at(0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 列表项："- 内容"、"* 内容"、"+ 内容"或"1. 内容"（trimmed为去掉首尾空白后的行）
+static bool parseListItem(const QString &trimmed, bool &ordered, int &number, int &contentStart)
+{
+    int pos = 0;
+    if (!trimmed.isEmpty() && (trimmed.at(0) == QLatin1Char('-') || trimmed.at(0) == QLatin1Char('*') ||
+                               trimmed.at(0) == QLatin1Char('+'))) {
+        ordered = false;
+        number = 1;
+        pos = 1;
+    } else {
+        while (pos < trimmed.size() && trimmed.at(pos).isDigit()) {
+            ++pos;
+        }
+        if (pos == 0 || pos >= trimmed.size() || trimmed.at(pos) != QLatin1Char('.')) {
+            return false;
+        }
+        ordered = true;
+        number = trimmed.left(pos).toInt();
+        ++pos;
+    }
+
+    if (pos >= trimmed.size() || !trimmed.at(pos).isSpace()) {
+        return false;
+    }
+    while (pos < trimmed.size() && trimmed.at(pos).isSpace()) {
+        ++pos;
+    }
+    contentStart = pos;
+    return pos < trimmed.size();
+}
+
+static bool startsWithSpanOf(const InlineContext &ctx, const QString &trimmed, ProtectedSpan::Kind kind)
+{
+    if (trimmed.isEmpty() || trimmed.at(0) != kSpanBegin) {
+        return false;
+    }
+    int next = 0;
+    const int index = parseSpanMarker(trimmed, 0, trimmed.size(), next);
+    return index >= 0 && index < ctx.spans.size() && ctx.spans.at(index).kind == kind;
+}
+
+// 第二步：逐行识别块级结构
+static QString renderBlocks(const InlineContext &ctx, const QString &text)
+{
+    const QStringList lines = text.split(QLatin1Char('\n'));
+    QStringList output;
+    QStringList paragraph;
+
+    // 嵌套列表状态：每层的类型（true为有序）和缩进
+    QVector<bool> listOrdered;
+    QVector<int> listIndents;
+
+    auto flushParagraph = [&]() {
+        if (!paragraph.isEmpty()) {
+            output.append("<p>" + paragraph.join(QLatin1Char(' ')) + "</p>");
+            paragraph.clear();
+        }
+    };
+    auto closeListLevel = [&]() {
+        output.append(listOrdered.last() ? "</ol>" : "</ul>");
+        listOrdered.removeLast();
+        listIndents.removeLast();
+    };
+    auto closeLists = [&]() {
+        while (!listOrdered.isEmpty()) {
+            closeListLevel();
+        }
+    };
+    auto appendBlock = [&](const QString &html) {
+        flushParagraph();
+        closeLists();
+        output.append(html);
+    };
+
+    // 不构成表格的连续"|...|"行按普通行处理，记录范围避免重复检查
+    int plainRowsUntil = 0;
+
+    for (int k = 0; k < lines.size(); ++k) {
+        const QString &line = lines.at(k);
+        const QString trimmed = line.trimmed();
+
+        if (trimmed.isEmpty()) {
+            flushParagraph();
+            closeLists();
+            continue;
+        }
+
+        if (k >= plainRowsUntil && isTableRow(line)) {
+            int last = k + 1;
+            while (last < lines.size() && isTableRow(lines.at(last))) {
+                ++last;
+            }
+            if (last - k >= 2 && isTableSeparator(lines.at(k + 1))) {
+                appendBlock(renderTable(ctx, lines, k, last));
+                k = last - 1;
+                continue;
+            }
+            plainRowsUntil = last;
+        }
+
+        if (startsWithSpanOf(ctx, trimmed, ProtectedSpan::CodeBlock) ||
+            startsWithSpanOf(ctx, trimmed, ProtectedSpan::MathBlock)) {
+            appendBlock(renderInline(ctx, trimmed));
+            continue;
+        }
+
+        const int level = headingLevel(line);
+        if (level > 0) {
+            appendBlock(QString("<h%1>%2</h%1>").arg(level)
+                        .arg(renderInline(ctx, line, level + 1, line.size()).trimmed()));
+            continue;
+        }
+
+        if (isHorizontalRule(line)) {
+            appendBlock("<hr>");
+            continue;
+        }
+
+        if (line.startsWith(QLatin1String("> ")) && line.size() > 2) {
+            appendBlock("<blockquote>" + renderInline(ctx, line, 2, line.size()).trimmed() + "</blockquote>");
+            continue;
+        }
+
+        bool ordered = false;
+        int number = 1;
+        int contentStart = 0;
+        if (parseListItem(trimmed, ordered, number, contentStart)) {
+            flushParagraph();
+            const int indent = leadingWhitespace(line);
+            while (!listIndents.isEmpty() && indent < listIndents.last()) {
+                closeListLevel();
+            }
+            if (!listIndents.isEmpty() && indent == listIndents.last() && listOrdered.last() != ordered) {
+                closeListLevel();
+            }
+            if (listIndents.isEmpty() || indent > listIndents.last()) {
+                output.append(ordered ? QString("<ol start=\"%1\">").arg(number) : QString("<ul>"));
+                listOrdered.append(ordered);
+                listIndents.append(indent);
+            }
+            output.append("<li>" + renderInline(ctx, trimmed, contentStart, trimmed.size()) + "</li>");
+            continue;
+        }
+
+        closeLists();
+        paragraph.append(renderInline(ctx, trimmed));
+    }
+
+    flushParagraph();
+    closeLists();
+
+    return output.join(QLatin1Char('\n'));
+}
+
+static QString normalizeLineEndings(const QString &markdown)
+{
+    QString source = markdown;
+    source.replace(QLatin1String("\r\n"), QLatin1String("\n"));
+    source.replace(QLatin1Char('\r'), QLatin1Char('\n'));
+    return source;
+}
+
+namespace MarkdownTokenizer {
+
+QString toHtml(const QString &markdown, const QMap<QString, QString> &images, const QString &imageBaseDir)
+{
+    const QString source = normalizeLineEndings(markdown);
+
+    QVector<ProtectedSpan> spans;
+    const QString text = extractProtectedSpans(source, spans);
+
+    const InlineContext ctx{spans, images, imageBaseDir};
+    return renderBlocks(ctx, text);
+}
+
+QStringList mathSpans(const QString &markdown)
+{
+    const QString source = normalizeLineEndings(markdown);
+
+    QVector<ProtectedSpan> spans;
+    extractProtectedSpans(source, spans);
+
+    QStringList result;
+    for (const ProtectedSpan &span : spans) {
+        if (span.kind == ProtectedSpan::MathBlock || span.kind == ProtectedSpan::MathInline) {
+            result.append(span.raw);
+        }
+    }
+    return result;
+}
+
+QUrl resolveImageUrl(const QString &src, const QMap<QString, QString> &images, const QString &imageBaseDir)
+{
+    QString resolvedSrc = src;
+    const QString key = src.trimmed();
+    if (!key.isEmpty() && images.contains(key)) {
+        const QString mapped = images.value(key).trimmed();
+        if (!mapped.isEmpty()) {
+            resolvedSrc = mapped;
+        }
+    }
+
+    if (resolvedSrc.startsWith("http://", Qt::CaseInsensitive) ||
+        resolvedSrc.startsWith("https://", Qt::CaseInsensitive) ||
+        resolvedSrc.startsWith("file://", Qt::CaseInsensitive)) {
+        return QUrl(resolvedSrc);
+    }
+
+    if (QDir::isAbsolutePath(resolvedSrc)) {
+        QString chosenPath = resolvedSrc;
+        if (!imageBaseDir.trimmed().isEmpty()) {
+            const QString fileName = QFileInfo(resolvedSrc).fileName();
+            if (!fileName.isEmpty()) {
+                const QString localCandidate = QDir(imageBaseDir).filePath(QString("asset/%1").arg(fileName));
+                if (QFileInfo::exists(localCandidate)) {
+                    chosenPath = localCandidate;
+                }
+            }
+        }
+        return QUrl::fromLocalFile(chosenPath);
+    }
+
+    if (!imageBaseDir.trimmed().isEmpty()) {
+        return QUrl::fromLocalFile(QDir(imageBaseDir).filePath(resolvedSrc));
+    }
+    return QUrl(resolvedSrc);
+}
+
+}
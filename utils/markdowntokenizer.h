@@ -0,0 +1,33 @@
+#ifndef MARKDOWNTOKENIZER_H
+#define MARKDOWNTOKENIZER_H
+
+#include <QString>
+#include <QStringList>
+#include <QMap>
+#include <QUrl>
+
+// 题目文本使用的Markdown子集的线性时间转换器
+//
+// 支持的语法与原有的正则转换器（见tools/markdownbench）一致：
+// 标题、粗体/斜体/粗斜体、删除线、行内代码、代码块、$/$$公式保护、
+// 图片（含图片键替换）、链接、引用、分割线、嵌套列表、表格和段落。
+//
+// 转换分两步，均为线性扫描：
+// 1. 扫描原文，把代码块、行内代码和公式取出放入旁表，原位置留下占位符；
+// 2. 逐行识别块级结构，行内元素由单遍发射器输出，遇到占位符时还原对应内容。
+// 查找闭合标记失败后会记住"后面不再有该标记"，避免病态输入下的重复扫描。
+namespace MarkdownTokenizer {
+
+QString toHtml(const QString &markdown,
+               const QMap<QString, QString> &images = QMap<QString, QString>(),
+               const QString &imageBaseDir = QString());
+
+// 按与toHtml相同的规则找出文本中的公式（带定界符），用于公式预渲染
+QStringList mathSpans(const QString &markdown);
+
+// 将图片src（可能是图片键、相对路径、绝对路径或URL）解析为最终URL
+QUrl resolveImageUrl(const QString &src, const QMap<QString, QString> &images, const QString &imageBaseDir);
+
+}
+
+#endif // MARKDOWNTOKENIZER_H
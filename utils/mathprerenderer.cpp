@@ -0,0 +1,307 @@
+#include "mathprerenderer.h"
+#include "markdowntokenizer.h"
+#include "resourceschemehandler.h"
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPointer>
+#include <QSaveFile>
+#include <QSet>
+#include <QStandardPaths>
+#include <QUrl>
+#include <QWebEnginePage>
+
+// 每次runJavaScript处理的公式数量，避免单次脚本执行时间过长
+static const int kBatchSize = 100;
+
+// 公式哈希 -> 预渲染HTML，所有渲染器共享
+static QHash<QByteArray, QString> &mathCache()
+{
+    static QHash<QByteArray, QString> cache;
+    return cache;
+}
+
+static int s_generation = 0;
+
+static QByteArray mathKey(const QString &rawMath)
+{
+    return QCryptographicHash::hash(rawMath.toUtf8(), QCryptographicHash::Sha1);
+}
+
+static QByteArray fingerprintOf(const QStringList &texts)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const QString &text : texts) {
+        hash.addData(text.toUtf8());
+        hash.addData(QByteArray(1, '\0'));
+    }
+    return hash.result();
+}
+
+MathPrerenderer *MathPrerenderer::instance()
+{
+    static QPointer<MathPrerenderer> prerenderer;
+    if (!prerenderer) {
+        prerenderer = new MathPrerenderer(QCoreApplication::instance());
+    }
+    return prerenderer;
+}
+
+MathPrerenderer::MathPrerenderer(QObject *parent)
+    : QObject(parent)
+    , m_page(nullptr)
+    , m_pageReady(false)
+    , m_batchRunning(false)
+{
+    // 离屏页面必须在QApplication析构之前释放
+    if (QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+                this, [this]() {
+                    // 共享Profile释放前页面必须已经删除，这里不能用deleteLater
+                    m_jobs.clear();
+                    delete m_page;
+                    m_page = nullptr;
+                    m_pageReady = false;
+                    m_batchRunning = false;
+                });
+    }
+}
+
+QString MathPrerenderer::cachedHtml(const QString &rawMath)
+{
+    const QHash<QByteArray, QString> &cache = mathCache();
+    if (cache.isEmpty()) {
+        return QString();
+    }
+    return cache.value(mathKey(rawMath));
+}
+
+int MathPrerenderer::generation()
+{
+    return s_generation;
+}
+
+void MathPrerenderer::prerenderBank(const QString &bankKey, const QStringList &markdownTexts)
+{
+    const QByteArray fingerprint = fingerprintOf(markdownTexts);
+    if (m_doneBanks.value(bankKey) == fingerprint) {
+        return;
+    }
+    for (const Job &job : m_jobs) {
+        if (job.bankKey == bankKey && job.fingerprint == fingerprint) {
+            return;
+        }
+    }
+
+    if (loadBankCache(bankKey, fingerprint)) {
+        m_doneBanks.insert(bankKey, fingerprint);
+        emit bankPrerendered(bankKey);
+        return;
+    }
+
+    Job job;
+    job.bankKey = bankKey;
+    job.fingerprint = fingerprint;
+    QSet<QString> seen;
+    for (const QString &text : markdownTexts) {
+        for (const QString &rawMath : MarkdownTokenizer::mathSpans(text)) {
+            if (seen.contains(rawMath)) {
+                continue;
+            }
+            seen.insert(rawMath);
+            job.allMath.append(rawMath);
+            if (cachedHtml(rawMath).isNull()) {
+                job.pendingMath.append(rawMath);
+            }
+        }
+    }
+
+    if (job.pendingMath.isEmpty()) {
+        finishJob(job);
+        return;
+    }
+
+    qDebug() << "Prerendering" << job.pendingMath.size() << "formulas for bank" << bankKey;
+    m_jobs.append(job);
+    ensurePage();
+    processNextBatch();
+}
+
+void MathPrerenderer::ensurePage()
+{
+    if (m_page) {
+        return;
+    }
+
+    m_pageReady = false;
+    m_page = new QWebEnginePage(ResourceSchemeHandler::sharedProfile(), this);
+    connect(m_page, &QWebEnginePage::loadFinished, this, &MathPrerenderer::onPageLoadFinished);
+
+    const QUrl baseUrl = ResourceSchemeHandler::resourcesBaseUrl();
+    m_page->setHtml("<!DOCTYPE html><html><head><meta charset=\"utf-8\">"
+                    "<script src=\"katex/katex.min.js\"></script></head><body></body></html>",
+                    baseUrl);
+}
+
+void MathPrerenderer::releasePage()
+{
+    if (m_page) {
+        m_page->deleteLater();
+        m_page = nullptr;
+    }
+    m_pageReady = false;
+    m_batchRunning = false;
+}
+
+void MathPrerenderer::onPageLoadFinished(bool success)
+{
+    if (!success) {
+        qDebug() << "Failed to load KaTeX page for math prerendering";
+        m_jobs.clear();
+        releasePage();
+        return;
+    }
+
+    m_pageReady = true;
+    processNextBatch();
+}
+
+void MathPrerenderer::processNextBatch()
+{
+    if (!m_pageReady || m_batchRunning) {
+        return;
+    }
+    if (m_jobs.isEmpty()) {
+        // 队列处理完后释放离屏页面，下次有新题库时再创建
+        releasePage();
+        return;
+    }
+
+    const QStringList batch = m_jobs.first().pendingMath.mid(0, kBatchSize);
+    QJsonArray items;
+    for (const QString &rawMath : batch) {
+        const bool display = rawMath.startsWith("$$");
+        const int delimiter = display ? 2 : 1;
+        QJsonArray item;
+        item.append(rawMath.mid(delimiter, rawMath.size() - 2 * delimiter));
+        item.append(display);
+        items.append(item);
+    }
+
+    const QString script = QString(
+        "(function(items) {"
+        "  if (typeof katex === 'undefined') { return null; }"
+        "  return items.map(function(item) {"
+        "    try { return katex.renderToString(item[0], {displayMode: item[1], throwOnError: false}); }"
+        "    catch (e) { return ''; }"
+        "  });"
+        "})(%1)")
+        .arg(QString::fromUtf8(QJsonDocument(items).toJson(QJsonDocument::Compact)));
+
+    m_batchRunning = true;
+    QPointer<MathPrerenderer> self(this);
+    m_page->runJavaScript(script, [self, batch](const QVariant &result) {
+        if (!self || self->m_jobs.isEmpty()) {
+            return;
+        }
+        self->m_batchRunning = false;
+
+        if (!result.isValid() || result.isNull()) {
+            qDebug() << "KaTeX is not available, math prerendering skipped for bank" << self->m_jobs.first().bankKey;
+            self->m_jobs.removeFirst();
+            self->processNextBatch();
+            return;
+        }
+
+        const QVariantList rendered = result.toList();
+        bool added = false;
+        for (int i = 0; i < batch.size() && i < rendered.size(); ++i) {
+            const QString html = rendered.at(i).toString();
+            if (!html.isEmpty()) {
+                mathCache().insert(mathKey(batch.at(i)), html);
+                added = true;
+            }
+        }
+        if (added) {
+            ++s_generation;
+        }
+
+        Job &job = self->m_jobs.first();
+        job.pendingMath = job.pendingMath.mid(batch.size());
+        if (job.pendingMath.isEmpty()) {
+            const Job finished = self->m_jobs.takeFirst();
+            self->finishJob(finished);
+        }
+        self->processNextBatch();
+    });
+}
+
+void MathPrerenderer::finishJob(const Job &job)
+{
+    saveBankCache(job);
+    m_doneBanks.insert(job.bankKey, job.fingerprint);
+    emit bankPrerendered(job.bankKey);
+}
+
+QString MathPrerenderer::cacheFilePath(const QString &bankKey)
+{
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    const QString name = QString::fromLatin1(
+        QCryptographicHash::hash(bankKey.toUtf8(), QCryptographicHash::Sha1).toHex());
+    return QDir(dir).filePath("katex/" + name + ".json");
+}
+
+bool MathPrerenderer::loadBankCache(const QString &bankKey, const QByteArray &fingerprint)
+{
+    QFile file(cacheFilePath(bankKey));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (QByteArray::fromHex(root.value("fingerprint").toString().toLatin1()) != fingerprint) {
+        return false;
+    }
+
+    const QJsonObject entries = root.value("entries").toObject();
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+        mathCache().insert(QByteArray::fromHex(it.key().toLatin1()), it.value().toString());
+    }
+    if (!entries.isEmpty()) {
+        ++s_generation;
+    }
+    return true;
+}
+
+void MathPrerenderer::saveBankCache(const Job &job) const
+{
+    QJsonObject entries;
+    for (const QString &rawMath : job.allMath) {
+        const QByteArray key = mathKey(rawMath);
+        const QString html = mathCache().value(key);
+        if (!html.isEmpty()) {
+            entries.insert(QString::fromLatin1(key.toHex()), html);
+        }
+    }
+
+    QJsonObject root;
+    root.insert("bank", job.bankKey);
+    root.insert("fingerprint", QString::fromLatin1(job.fingerprint.toHex()));
+    root.insert("entries", entries);
+
+    const QString filePath = cacheFilePath(job.bankKey);
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Cannot write math prerender cache:" << filePath;
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    file.commit();
+}
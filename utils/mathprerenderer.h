@@ -0,0 +1,78 @@
+#ifndef MATHPRERENDERER_H
+#define MATHPRERENDERER_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+class QWebEnginePage;
+
+/**
+ * @brief KaTeX公式预渲染缓存
+ *
+ * 题目显示时由页面脚本调用renderMathInElement排版公式，公式多的科目首屏很慢。
+ * 预渲染器在一个离屏QWebEnginePage中运行KaTeX，按题库批量把题干和选项中的公式
+ * 转换成HTML，结果按公式内容的哈希缓存，并按题库写入缓存目录。
+ * MarkdownRenderer转换Markdown时直接插入缓存的HTML，页面不再需要排版这些公式。
+ * 同一题库内容不变时只处理一次。
+ */
+class MathPrerenderer : public QObject
+{
+    Q_OBJECT
+
+public:
+    static MathPrerenderer *instance();
+
+    /**
+     * @brief 预渲染一个题库中的全部公式（异步，已处理过且内容未变时直接返回）
+     * @param bankKey 题库标识（如科目名+题库文件）
+     * @param markdownTexts 题库中所有题干和选项的Markdown文本
+     */
+    void prerenderBank(const QString &bankKey, const QStringList &markdownTexts);
+
+    /**
+     * @brief 查询公式的预渲染结果
+     * @param rawMath 带定界符的公式原文（$...$或$$...$$）
+     * @return 预渲染的HTML，没有缓存时返回空QString
+     */
+    static QString cachedHtml(const QString &rawMath);
+
+    /**
+     * @brief 缓存版本号，每次有新的预渲染结果加入时递增
+     * 已转换HTML的缓存需要把它作为键的一部分
+     */
+    static int generation();
+
+signals:
+    void bankPrerendered(const QString &bankKey);
+
+private slots:
+    void onPageLoadFinished(bool success);
+
+private:
+    struct Job {
+        QString bankKey;
+        QByteArray fingerprint;
+        QStringList allMath;        // 题库中出现的全部公式（写缓存文件用）
+        QStringList pendingMath;    // 还没有缓存的公式
+    };
+
+    explicit MathPrerenderer(QObject *parent = nullptr);
+    void ensurePage();
+    void processNextBatch();
+    void finishJob(const Job &job);
+    bool loadBankCache(const QString &bankKey, const QByteArray &fingerprint);
+    void saveBankCache(const Job &job) const;
+    static QString cacheFilePath(const QString &bankKey);
+    void releasePage();
+
+    QWebEnginePage *m_page;
+    bool m_pageReady;
+    bool m_batchRunning;
+    QList<Job> m_jobs;
+    QHash<QString, QByteArray> m_doneBanks;     // 题库标识 -> 已处理内容的指纹
+};
+
+#endif // MATHPRERENDERER_H
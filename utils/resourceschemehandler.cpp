@@ -0,0 +1,193 @@
+#include "resourceschemehandler.h"
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QImageReader>
+#include <QMimeDatabase>
+#include <QPointer>
+#include <QWebEngineProfile>
+#include <QWebEngineUrlRequestJob>
+#include <QWebEngineUrlScheme>
+
+static const QByteArray kSchemeName = "problemx";
+static const QString kResourcesHost = QStringLiteral("resources");
+static const QString kImageHost = QStringLiteral("image");
+
+// 超过该尺寸的图片缩小后再交给页面，题目中的图片不需要原始分辨率
+static const int kMaxImageDimension = 1600;
+
+static QPointer<ResourceSchemeHandler> s_handler;
+
+void ResourceSchemeHandler::registerScheme()
+{
+    QWebEngineUrlScheme scheme(kSchemeName);
+    scheme.setSyntax(QWebEngineUrlScheme::Syntax::Host);
+    // 与原来的file://页面一样可以访问本地和远程资源
+    scheme.setFlags(QWebEngineUrlScheme::SecureScheme |
+                    QWebEngineUrlScheme::LocalScheme |
+                    QWebEngineUrlScheme::LocalAccessAllowed |
+                    QWebEngineUrlScheme::CorsEnabled);
+    QWebEngineUrlScheme::registerScheme(scheme);
+}
+
+QWebEngineProfile *ResourceSchemeHandler::sharedProfile()
+{
+    static QPointer<QWebEngineProfile> profile;
+    if (!profile) {
+        profile = new QWebEngineProfile(QCoreApplication::instance());
+        s_handler = new ResourceSchemeHandler(profile);
+        profile->installUrlSchemeHandler(kSchemeName, s_handler);
+    }
+    return profile;
+}
+
+QUrl ResourceSchemeHandler::resourcesBaseUrl()
+{
+    return QUrl(QString::fromLatin1(kSchemeName) + "://" + kResourcesHost + "/");
+}
+
+QString ResourceSchemeHandler::rewriteImageUrls(const QString &html)
+{
+    if (!html.contains("src=\"file:///")) {
+        return html;
+    }
+    QString result = html;
+    result.replace("src=\"file:///", "src=\"" + QString::fromLatin1(kSchemeName) + "://" + kImageHost + "/");
+    return result;
+}
+
+void ResourceSchemeHandler::clearImageCache()
+{
+    if (s_handler) {
+        s_handler->m_images.clear();
+    }
+}
+
+ResourceSchemeHandler::ResourceSchemeHandler(QObject *parent)
+    : QWebEngineUrlSchemeHandler(parent)
+    , m_resourcesRoot(QDir::cleanPath(QCoreApplication::applicationDirPath() + "/resources"))
+    , m_images(64 * 1024 * 1024)
+{
+}
+
+void ResourceSchemeHandler::requestStarted(QWebEngineUrlRequestJob *job)
+{
+    const QUrl url = job->requestUrl();
+    Resource resource;
+    bool found = false;
+
+    if (url.host() == kResourcesHost) {
+        found = staticResource(url.path(), resource);
+    } else if (url.host() == kImageHost) {
+        // problemx://image/<路径> 与 file:///<路径> 对应
+        QUrl fileUrl;
+        fileUrl.setScheme("file");
+        fileUrl.setPath(url.path());
+        found = imageResource(fileUrl.toLocalFile(), resource);
+    }
+
+    if (!found) {
+        job->fail(QWebEngineUrlRequestJob::UrlNotFound);
+        return;
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+    // 资源内容在程序运行期间不变，允许页面直接使用缓存
+    QMultiMap<QByteArray, QByteArray> headers;
+    headers.insert("Cache-Control", "public, max-age=31536000, immutable");
+    job->setAdditionalResponseHeaders(headers);
+#endif
+
+    QBuffer *buffer = new QBuffer(job);
+    buffer->setData(resource.data);
+    buffer->open(QIODevice::ReadOnly);
+    job->reply(resource.mimeType, buffer);
+}
+
+bool ResourceSchemeHandler::staticResource(const QString &relativePath, Resource &resource)
+{
+    auto it = m_staticResources.constFind(relativePath);
+    if (it != m_staticResources.constEnd()) {
+        resource = it.value();
+        return true;
+    }
+
+    // 只允许访问resources目录之内的文件
+    const QString filePath = QDir::cleanPath(m_resourcesRoot + "/" + relativePath);
+    if (!filePath.startsWith(m_resourcesRoot + "/")) {
+        return false;
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "Resource not found:" << filePath;
+        return false;
+    }
+
+    resource.data = file.readAll();
+    resource.mimeType = mimeTypeForPath(filePath);
+    m_staticResources.insert(relativePath, resource);
+    return true;
+}
+
+bool ResourceSchemeHandler::imageResource(const QString &localPath, Resource &resource)
+{
+    if (const Resource *cached = m_images.object(localPath)) {
+        resource = *cached;
+        return true;
+    }
+
+    // 题目内容来自导入的题库，只提供能识别为图片的文件，其他本地文件一律拒绝
+    QImageReader reader(localPath);
+    if (!reader.canRead()) {
+        qDebug() << "Refusing non-image resource:" << localPath;
+        return false;
+    }
+    const QSize originalSize = reader.size();
+    if (!originalSize.isValid()) {
+        qDebug() << "Refusing image without a readable size:" << localPath;
+        return false;
+    }
+
+    if (originalSize.width() > kMaxImageDimension || originalSize.height() > kMaxImageDimension) {
+        // 大图在解码时直接缩小，缓存PNG编码结果
+        reader.setScaledSize(originalSize.scaled(kMaxImageDimension, kMaxImageDimension, Qt::KeepAspectRatio));
+        const QImage image = reader.read();
+        if (image.isNull()) {
+            return false;
+        }
+        QBuffer buffer(&resource.data);
+        buffer.open(QIODevice::WriteOnly);
+        image.save(&buffer, "PNG");
+        resource.mimeType = "image/png";
+    } else {
+        // 尺寸合适的图片直接缓存原始文件内容
+        QFile file(localPath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return false;
+        }
+        resource.data = file.readAll();
+        // 按文件内容识别出的格式返回类型，扩展名与内容不符时不会被当成其他类型处理
+        resource.mimeType = "image/" + reader.format().toLower();
+        if (resource.mimeType == "image/jpg") {
+            resource.mimeType = "image/jpeg";
+        } else if (resource.mimeType == "image/svg") {
+            resource.mimeType = "image/svg+xml";
+        }
+    }
+
+    // 超过缓存容量的单张图片QCache不会保存，本次仍然正常返回
+    m_images.insert(localPath, new Resource(resource), qMax(1, resource.data.size()));
+    return true;
+}
+
+QByteArray ResourceSchemeHandler::mimeTypeForPath(const QString &path)
+{
+    // 只按扩展名判断，不读取文件内容
+    static const QMimeDatabase mimeDatabase;
+    return mimeDatabase.mimeTypeForFile(path, QMimeDatabase::MatchExtension).name().toLatin1();
+}
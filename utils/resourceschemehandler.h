@@ -0,0 +1,69 @@
+#ifndef RESOURCESCHEMEHANDLER_H
+#define RESOURCESCHEMEHANDLER_H
+
+#include <QWebEngineUrlSchemeHandler>
+#include <QByteArray>
+#include <QCache>
+#include <QHash>
+#include <QString>
+#include <QUrl>
+
+class QWebEngineProfile;
+
+/**
+ * @brief 题目页面的内存资源协议（problemx://）
+ *
+ * - problemx://resources/... 对应程序目录下resources中的文件（KaTeX脚本、样式和字体），
+ *   第一次请求时读入内存，之后直接从内存返回
+ * - problemx://image/<本地路径> 对应题目图片，解码后按最大尺寸缩小并缓存编码结果；
+ *   无法识别为图片的文件返回UrlNotFound，页面不能借此读取任意本地文件
+ *
+ * 所有题目页面共用sharedProfile()，处理器只安装一次。
+ * 协议必须在创建QApplication之前调用registerScheme()注册。
+ */
+class ResourceSchemeHandler : public QWebEngineUrlSchemeHandler
+{
+    Q_OBJECT
+
+public:
+    static void registerScheme();
+
+    /**
+     * @brief 安装了资源协议处理器的共享Profile
+     */
+    static QWebEngineProfile *sharedProfile();
+
+    /**
+     * @brief 页面的基础URL，相对路径的KaTeX资源由内存提供
+     */
+    static QUrl resourcesBaseUrl();
+
+    /**
+     * @brief 把HTML中的本地图片地址（file://）改写为资源协议地址
+     */
+    static QString rewriteImageUrls(const QString &html);
+
+    /**
+     * @brief 清除已缓存的图片（题库图片在外部被修改时调用）
+     */
+    static void clearImageCache();
+
+    void requestStarted(QWebEngineUrlRequestJob *job) override;
+
+private:
+    struct Resource {
+        QByteArray data;
+        QByteArray mimeType;
+    };
+
+    explicit ResourceSchemeHandler(QObject *parent = nullptr);
+    bool staticResource(const QString &relativePath, Resource &resource);
+    bool imageResource(const QString &localPath, Resource &resource);
+    static QByteArray mimeTypeForPath(const QString &path);
+
+    QString m_resourcesRoot;
+    QHash<QString, Resource> m_staticResources;     // 静态资源数量有限，全部常驻内存
+    QCache<QString, Resource> m_images;             // 成本按编码后的字节数计算
+};
+
+#endif // RESOURCESCHEMEHANDLER_H
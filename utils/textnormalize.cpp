@@ -64,5 +64,66 @@ QStringList makeSearchGrams(const QString &text)
     return makeNGrams(normalized, n);
 }
 
+static QChar foldAnswerChar(const QChar &c)
+{
+    const uint u = c.unicode();
+    if (u == 0x3000) {
+        return QLatin1Char(' ');
+    }
+    if (u >= 0xFF01 && u <= 0xFF5E) {
+        return QChar(u - 0xFEE0).toUpper();
+    }
+    return c.toUpper();
 }
 
+QString normalizeAnswer(const QString &text)
+{
+    QString out;
+    out.reserve(text.size());
+
+    bool pendingSpace = false;
+    for (const QChar &c : text) {
+        const QChar folded = foldAnswerChar(c);
+        if (folded.isSpace()) {
+            pendingSpace = !out.isEmpty();
+            continue;
+        }
+        if (pendingSpace) {
+            out.append(QLatin1Char(' '));
+            pendingSpace = false;
+        }
+        out.append(folded);
+    }
+
+    return out;
+}
+
+bool matchesNormalizedAnswer(const QString &text, const QString &normalizedKey)
+{
+    const int keySize = normalizedKey.size();
+    int pos = 0;
+    bool pendingSpace = false;
+
+    for (const QChar &c : text) {
+        const QChar folded = foldAnswerChar(c);
+        if (folded.isSpace()) {
+            pendingSpace = pos > 0;
+            continue;
+        }
+        if (pendingSpace) {
+            if (pos >= keySize || normalizedKey.at(pos) != QLatin1Char(' ')) {
+                return false;
+            }
+            ++pos;
+            pendingSpace = false;
+        }
+        if (pos >= keySize || normalizedKey.at(pos) != folded) {
+            return false;
+        }
+        ++pos;
+    }
+
+    return pos == keySize;
+}
+
+}
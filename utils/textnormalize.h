@@ -10,6 +10,11 @@ QString normalizeForSearch(const QString &text);
 QStringList makeNGrams(const QString &normalizedText, int n);
 QStringList makeSearchGrams(const QString &text);
 
+// 答案判定用的规范化：全角转半角、统一大写、去除首尾空白并把连续空白折叠为一个空格
+QString normalizeAnswer(const QString &text);
+// 将原始文本按normalizeAnswer的规则逐字符与已规范化的key比较，不分配临时字符串
+bool matchesNormalizedAnswer(const QString &text, const QString &normalizedKey);
+
 }
 
 #endif // TEXTNORMALIZE_H
@@ -364,7 +364,7 @@ void ConfigWidget::setupConnections()
                     return;
                 }
                 m_configManager->setShuffleQuestionsEnabled(enabled);
-                m_configManager->saveConfig();
+                m_configManager->scheduleSave();
                 emit configurationChanged();
             });
 }
@@ -675,7 +675,7 @@ void ConfigWidget::onSubjectSelectionChanged()
         // 同步当前科目到ConfigManager并保存配置
         if (m_configManager) {
             m_configManager->setCurrentSubject(m_currentSubject);
-            m_configManager->saveConfig(); // 保存当前科目设置
+            m_configManager->scheduleSave(); // 保存当前科目设置
             qDebug() << "Set current subject in ConfigManager:" << m_currentSubject;
         }
         
@@ -713,7 +713,7 @@ void ConfigWidget::onSubjectSelectionChanged()
             // 同步当前科目到ConfigManager并保存配置
             if (m_configManager) {
                 m_configManager->setCurrentSubject(m_currentSubject);
-                m_configManager->saveConfig(); // 保存当前科目设置
+                m_configManager->scheduleSave(); // 保存当前科目设置
                 qDebug() << "Set current subject in ConfigManager:" << m_currentSubject;
             }
             
@@ -1062,7 +1062,7 @@ void ConfigWidget::onBankCheckStateChanged(QTreeWidgetItem *item, int column)
     }
 
     m_configManager->setQuestionBank(cleanedSubject, bank);
-    m_configManager->saveConfig();
+    m_configManager->scheduleSave();
 
     item->setText(1, enabled ? "已启用" : "未启用");
 
@@ -1189,8 +1189,8 @@ void ConfigWidget::onExtractCountChanged(int count)
         // 更新配置管理器中的数据
         m_configManager->setQuestionBank(cleanedSubject, bank);
         
-        // 自动保存配置到文件
-        m_configManager->saveConfig();
+        // 拖动滑块时会连续触发，合并为一次保存
+        m_configManager->scheduleSave();
         
         // 更新父节点的统计信息
         QTreeWidgetItem *current = m_subjectTree->currentItem();
@@ -1309,14 +1309,14 @@ void ConfigWidget::onAddSubjectClicked()
         // 显示添加结果
         if (totalBanks > 0) {
             QMessageBox::information(this, "添加成功", 
-                QString("科目 '%1' 添加成功！\n\n找到题库：\n- 选择题：%2 个\n- 判断题：%3 个\n- 填空题：%4 个\n\n配置已自动保存到 config.json")
+                QString("科目 '%1' 添加成功！\n\n找到题库：\n- 选择题：%2 个\n- 判断题：%3 个\n- 填空题：%4 个\n\n配置已自动保存")
                 .arg(subjectName)
                 .arg(bank.getChoiceBanks().size())
                 .arg(bank.getTrueOrFalseBanks().size())
                 .arg(bank.getFillBlankBanks().size()));
         } else {
             QMessageBox::information(this, "添加成功", 
-                QString("科目 '%1' 添加成功！\n\n注意：在该科目文件夹中未找到有效的题库文件。\n请确保文件夹包含 Choice、TrueorFalse 或 FillBlank 子文件夹，\n并在其中放置相应的JSON题库文件。\n\n配置已自动保存到 config.json")
+                QString("科目 '%1' 添加成功！\n\n注意：在该科目文件夹中未找到有效的题库文件。\n请确保文件夹包含 Choice、TrueorFalse 或 FillBlank 子文件夹，\n并在其中放置相应的JSON题库文件。\n\n配置已自动保存")
                 .arg(subjectName));
         }
     }
@@ -1489,7 +1489,7 @@ void ConfigWidget::onRemoveSubjectClicked()
         
         // 显示成功消息
         QMessageBox::information(this, "删除成功", 
-            QString("科目 '%1' 已从配置中移除。\n\n科目文件夹仍保留在：\n%2\n\n配置已自动保存到 config.json")
+            QString("科目 '%1' 已从配置中移除。\n\n科目文件夹仍保留在：\n%2\n\n配置已自动保存")
             .arg(subject)
             .arg(subjectPath));
     }
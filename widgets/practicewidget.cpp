@@ -1,7 +1,9 @@
 #include "practicewidget.h"
 #include "../core/practicemanager.h"
 #include "../models/question.h"
+#include "../models/questionlistmodel.h"
 #include "../utils/markdownrenderer.h"
+#include "../utils/markdownrendererpool.h"
 #include <QSplitter>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -16,8 +18,7 @@
 #include <QScrollArea>
 #include <QProgressBar>
 #include <QTimer>
-#include <QListWidget>
-#include <QListWidgetItem>
+#include <QListView>
 #include <QButtonGroup>
 #include <QDebug>
 #include <QFile>
@@ -34,6 +35,7 @@
 #include <QDateTime>
 #include <QDebug>
 #include <QSet>
+#include <QSignalBlocker>
 
 PracticeWidget::PracticeWidget(QWidget *parent)
     : QWidget(parent)
@@ -43,6 +45,8 @@ PracticeWidget::PracticeWidget(QWidget *parent)
     , m_isAnswerSubmitted(false)
     , m_isPaused(false)
     , m_currentQuestionType(QuestionType::Choice)
+    , m_prefetchTimer(nullptr)
+    , m_displayedQuestionIndex(-1)
 {
     setupUI();
     setupConnections();
@@ -53,6 +57,12 @@ PracticeWidget::PracticeWidget(QWidget *parent)
     m_timer = new QTimer(this);
     connect(m_timer, &QTimer::timeout, this, &PracticeWidget::updateTimer);
     m_timer->start(1000); // Update every second
+    
+    // 当前题目显示后稍等片刻再预取相邻题目，连续翻题时只处理最后停留的位置
+    m_prefetchTimer = new QTimer(this);
+    m_prefetchTimer->setSingleShot(true);
+    m_prefetchTimer->setInterval(50);
+    connect(m_prefetchTimer, &QTimer::timeout, this, &PracticeWidget::prefetchAdjacentQuestions);
 }
 
 PracticeWidget::~PracticeWidget()
@@ -84,6 +94,9 @@ void PracticeWidget::setPracticeManager(PracticeManager *practiceManager)
 void PracticeWidget::startPractice()
 {
     if (m_practiceManager) {
+        // 题目列表已经变化，之前预取的内容全部作废
+        clearPrefetchedRenderers();
+        
         // 对于新练习，总是从第一题开始；对于继续练习，使用QuestionManager的当前索引
         if (m_practiceManager->getCurrentMode() == PracticeMode::Resume) {
             // 继续练习：使用QuestionManager中保存的当前索引
@@ -163,7 +176,7 @@ void PracticeWidget::setupUI()
     m_questionContentLayout->setSpacing(15);
     
     // Question text and image - 使用MarkdownRenderer替换QLabel
-    m_questionTextRenderer = new MarkdownRenderer(this);
+    m_questionTextRenderer = MarkdownRendererPool::instance()->acquire(this);
     m_questionTextRenderer->setAutoResize(true, 600);  // 启用自动适配，最大高度600
     m_questionTextRenderer->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Minimum);
     
@@ -195,6 +208,8 @@ void PracticeWidget::setupUI()
     m_answerStack->addWidget(m_multiChoiceWidget);
     m_answerStack->addWidget(m_fillBlankWidget);
     
+    setupAnswerInputs();
+    
     m_questionContentLayout->addWidget(m_answerStack);
     m_questionContentLayout->addStretch();
     
@@ -272,10 +287,16 @@ void PracticeWidget::setupUI()
     m_questionListGroup = new QGroupBox("题目列表");
     m_questionListLayout = new QVBoxLayout(m_questionListGroup);
     
-    m_questionListWidget = new QListWidget();
-    m_questionListWidget->setMaximumHeight(300);
+    // 列表只绘制可见的行，所有行高度相同，不需要逐行计算尺寸
+    m_questionListModel = new QuestionListModel(this);
+    m_questionListView = new QListView();
+    m_questionListView->setModel(m_questionListModel);
+    m_questionListView->setUniformItemSizes(true);
+    m_questionListView->setSelectionMode(QAbstractItemView::NoSelection);
+    m_questionListView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_questionListView->setMaximumHeight(300);
     
-    m_questionListLayout->addWidget(m_questionListWidget);
+    m_questionListLayout->addWidget(m_questionListView);
     
     // Control buttons
     m_controlLayout = new QHBoxLayout();
@@ -314,11 +335,13 @@ void PracticeWidget::setupConnections()
     connect(m_finishButton, &QPushButton::clicked, this, &PracticeWidget::onFinishClicked);
     connect(m_backButton, &QPushButton::clicked, this, &PracticeWidget::onBackClicked);
     
-    connect(m_questionListWidget, &QListWidget::itemClicked,
+    connect(m_questionListView, &QListView::clicked,
             this, &PracticeWidget::onQuestionListItemClicked);
     
     connect(m_choiceButtonGroup, QOverload<QAbstractButton*>::of(&QButtonGroup::buttonClicked),
             this, &PracticeWidget::onChoiceSelected);
+    connect(m_questionTextRenderer, &MarkdownRenderer::choiceClicked,
+            this, &PracticeWidget::onRendererChoiceClicked);
 }
 
 void PracticeWidget::setupShortcuts()
@@ -575,25 +598,25 @@ void PracticeWidget::applyStyles()
         "    color: #495057;"
         "}"
         
-        "QListWidget {"
+        "QListView {"
         "    border: 1px solid #dee2e6;"
         "    border-radius: 4px;"
         "    background-color: white;"
         "    alternate-background-color: #f8f9fa;"
         "}"
         
-        "QListWidget::item {"
+        "QListView::item {"
         "    padding: 6px;"
         "    border-bottom: 1px solid #e9ecef;"
         "}"
         
-        "QListWidget::item:selected {"
+        "QListView::item:selected {"
         "    background-color: transparent;"
         "    color: inherit;"
         "    outline: none;"
         "}"
         
-        "QListWidget::item:selected:focus {"
+        "QListView::item:selected:focus {"
         "    background-color: transparent;"
         "    color: inherit;"
         "    outline: none;"
@@ -601,7 +624,7 @@ void PracticeWidget::applyStyles()
         
 
         
-        "QListWidget::item:hover {"
+        "QListView::item:hover {"
         "    opacity: 0.8;"
         "}"
         
@@ -645,7 +668,9 @@ void PracticeWidget::onQuestionChanged(int index, int total)
     m_totalQuestions = total;
     
     updateQuestionDisplay();
-    updateQuestionList();
+    // 只刷新原来和新的当前题目两行
+    m_questionListModel->setCurrentIndex(index);
+    scrollToCurrentQuestion();
     updateNavigationButtons();
     
     // 不再在这里隐藏结果框架，让updateQuestionDisplay方法来处理结果显示
@@ -654,15 +679,13 @@ void PracticeWidget::onQuestionChanged(int index, int total)
 
 void PracticeWidget::onAnswerSubmitted(int index, bool correct)
 {
-    Q_UNUSED(index)
-    
     qDebug() << "onAnswerSubmitted called: index=" << index << ", correct=" << correct;
     
     m_isAnswerSubmitted = true;
     
     // Get correct answer(s) and show result
     if (m_practiceManager) {
-        Question currentQuestion = m_practiceManager->getQuestionManager()->getCurrentQuestion();
+        const Question &currentQuestion = m_practiceManager->getQuestionManager()->getCurrentQuestion();
         qDebug() << "Question type:" << static_cast<int>(currentQuestion.getType());
         
         if (currentQuestion.getType() == QuestionType::FillBlank) {
@@ -684,7 +707,7 @@ void PracticeWidget::onAnswerSubmitted(int index, bool correct)
     
     setAnswerInputsEnabled(false);
     updateNavigationButtons();
-    updateQuestionList();
+    m_questionListModel->refreshQuestion(index);
 }
 
 void PracticeWidget::onProgressChanged(double progress)
@@ -800,13 +823,13 @@ void PracticeWidget::onFinishClicked()
     }
 }
 
-void PracticeWidget::onQuestionListItemClicked(QListWidgetItem *item)
+void PracticeWidget::onQuestionListItemClicked(const QModelIndex &index)
 {
-    if (!item || !m_practiceManager) {
+    if (!index.isValid() || !m_practiceManager) {
         return;
     }
     
-    int questionIndex = item->data(Qt::UserRole).toInt();
+    int questionIndex = index.data(QuestionListModel::QuestionIndexRole).toInt();
     
     // 如果点击的是当前题目，不需要切换
     if (questionIndex == m_currentQuestionIndex) {
@@ -816,13 +839,50 @@ void PracticeWidget::onQuestionListItemClicked(QListWidgetItem *item)
     m_practiceManager->goToQuestion(questionIndex);
     
     // goToQuestion会触发questionChanged信号，进而调用onQuestionChanged
-    // onQuestionChanged中会调用updateQuestionList，所以这里不需要额外调用
+    // onQuestionChanged中会更新题目列表，所以这里不需要额外调用
 }
 
 void PracticeWidget::onChoiceSelected()
 {
     // Enable submit button when choice is selected
     m_submitButton->setEnabled(!m_isAnswerSubmitted);
+    syncRendererChoiceSelection();
+}
+
+void PracticeWidget::onRendererChoiceClicked(int index)
+{
+    // 页面中点击选项等同于点击对应的选项按钮
+    if (m_isAnswerSubmitted) {
+        return;
+    }
+    
+    if (m_currentQuestionType == QuestionType::Choice) {
+        if (index >= 0 && index < m_choiceButtons.size() && m_choiceButtons[index]->isEnabled()) {
+            m_choiceButtons[index]->setChecked(true);
+        }
+    } else if (m_currentQuestionType == QuestionType::MultipleChoice) {
+        if (index >= 0 && index < m_multiChoiceBoxes.size() && m_multiChoiceBoxes[index]->isEnabled()) {
+            m_multiChoiceBoxes[index]->toggle();
+        }
+    }
+}
+
+void PracticeWidget::syncRendererChoiceSelection()
+{
+    QList<int> selected;
+    if (m_currentQuestionType == QuestionType::Choice) {
+        const int checkedId = m_choiceButtonGroup->checkedId();
+        if (checkedId >= 0) {
+            selected.append(checkedId);
+        }
+    } else if (m_currentQuestionType == QuestionType::MultipleChoice) {
+        for (int i = 0; i < m_multiChoiceBoxes.size(); ++i) {
+            if (m_multiChoiceBoxes[i]->isChecked()) {
+                selected.append(i);
+            }
+        }
+    }
+    m_questionTextRenderer->setSelectedChoices(selected);
 }
 
 void PracticeWidget::onFillBlankChanged()
@@ -853,7 +913,7 @@ void PracticeWidget::updateQuestionDisplay()
         return;
     }
     
-    Question currentQuestion = m_practiceManager->getQuestionManager()->getCurrentQuestion();
+    const Question &currentQuestion = m_practiceManager->getQuestionManager()->getCurrentQuestion();
     m_currentQuestionType = currentQuestion.getType();
     
     // Update header
@@ -882,6 +942,12 @@ void PracticeWidget::updateQuestionDisplay()
     
     m_questionImageLabel->setVisible(false);
     
+    // 已经预取的题目直接换上渲染好的渲染器，否则在当前渲染器中渲染
+    if (!activatePrefetchedRenderer(m_currentQuestionIndex)) {
+        renderQuestionContent(m_questionTextRenderer, currentQuestion);
+    }
+    m_displayedQuestionIndex = m_currentQuestionIndex;
+    
     // Display question based on type
     clearAnswerInputs();
     switch (m_currentQuestionType) {
@@ -912,8 +978,7 @@ void PracticeWidget::updateQuestionDisplay()
         m_isAnswerSubmitted = true;
         
         // 显示答题结果
-        bool isCorrect = m_practiceManager->getQuestionManager()->checkAnswer(m_currentQuestionIndex);
-        Question currentQuestion = m_practiceManager->getQuestionManager()->getCurrentQuestion();
+        bool isCorrect = m_practiceManager->getQuestionManager()->isAnswerCorrect(m_currentQuestionIndex);
         if (currentQuestion.getType() == QuestionType::FillBlank) {
             showAnswerResult(isCorrect, currentQuestion.getAnswers());
         } else if (currentQuestion.getType() == QuestionType::TrueOrFalse) {
@@ -930,239 +995,107 @@ void PracticeWidget::updateQuestionDisplay()
         m_isAnswerSubmitted = false;
         hideAnswerResult();
     }
+    
+    schedulePrefetch();
 }
 
 void PracticeWidget::displayChoiceQuestion(const Question &question)
 {
-    for (QAbstractButton *button : m_choiceButtonGroup->buttons()) {
-        m_choiceButtonGroup->removeButton(button);
-    }
-    while (QLayoutItem *item = m_choiceLayout->takeAt(0)) {
-        if (QWidget *w = item->widget()) {
-            w->deleteLater();
-        }
-        delete item;
-    }
-    m_choiceButtons.clear();
-    m_choiceRenderers.clear();
-    
-    QString imageBaseDir;
-    if (m_practiceManager) {
-        QString typeDir;
-        switch (question.getType()) {
-            case QuestionType::Choice:
-                typeDir = "Choice";
-                break;
-            case QuestionType::TrueOrFalse:
-                typeDir = "TrueOrFalse";
-                break;
-            case QuestionType::FillBlank:
-                typeDir = "FillBlank";
-                break;
-            case QuestionType::MultipleChoice:
-                typeDir = "MultiChoice";
-                break;
-            default:
-                typeDir = "Choice";
-                break;
-        }
-
-        const QString subjectPath = m_practiceManager->getCurrentSubjectPath();
-        if (!subjectPath.isEmpty()) {
-            imageBaseDir = QDir(subjectPath).filePath(typeDir);
-        } else {
-            const QString subjectName = m_practiceManager->getCurrentSession().subject;
-            imageBaseDir = QDir(QApplication::applicationDirPath()).filePath("Subject/" + subjectName + "/" + typeDir);
-        }
-    }
-
-    // 设置题目内容
-    m_questionTextRenderer->setContent(question.getQuestion(), question.getImages(), imageBaseDir);
-    
-    // 创建新的选项
+    // 题干和选项已由renderQuestionContent渲染到页面中
     const QStringList &choices = question.getChoices();
-    const QStringList labels = {"A", "B", "C", "D", "E", "F", "G", "H"};
+    const int choiceCount = qMin(choices.size(), m_choiceButtonPool.size());
     
-    for (int i = 0; i < choices.size() && i < labels.size(); ++i) {
-        // 创建选项容器
-        QWidget *choiceContainer = new QWidget();
-        choiceContainer->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Minimum);
-        QHBoxLayout *choiceLayout = new QHBoxLayout(choiceContainer);
-        choiceLayout->setContentsMargins(0, 0, 0, 0);
-        choiceLayout->setSpacing(10);
-        choiceLayout->setAlignment(Qt::AlignTop);
-        
-        // 创建单选按钮
-        QRadioButton *radioButton = new QRadioButton(labels[i]);
-        radioButton->setFixedWidth(30);
-        
-        // 创建选项内容渲染器
-        MarkdownRenderer *choiceRenderer = createChoiceRenderer(choices[i], question.getImages(), imageBaseDir);
-        
-        choiceLayout->addWidget(radioButton);
-        choiceLayout->addWidget(choiceRenderer, 1);
-        
-        m_choiceLayout->addWidget(choiceContainer);
-        
-        m_choiceButtons.append(radioButton);
-        m_choiceRenderers.append(choiceRenderer);
-        m_choiceButtonGroup->addButton(radioButton, i);
-        
-        connect(radioButton, &QRadioButton::toggled, this, &PracticeWidget::onChoiceSelected);
+    // 单选按钮只保留选项字母，用于键盘操作和显示当前选择
+    for (int i = 0; i < m_choiceButtonPool.size(); ++i) {
+        m_choiceButtonPool[i]->setVisible(i < choiceCount);
     }
-    
-    m_choiceLayout->addStretch();
+    m_trueFalsePanel->hide();
+    m_choiceRow->show();
+    bindChoiceButtons(m_choiceButtonPool.mid(0, choiceCount));
 }
 
 void PracticeWidget::displayTrueOrFalseQuestion(const Question &question)
 {
-    for (QAbstractButton *button : m_choiceButtonGroup->buttons()) {
-        m_choiceButtonGroup->removeButton(button);
-    }
-    while (QLayoutItem *item = m_choiceLayout->takeAt(0)) {
-        if (QWidget *w = item->widget()) {
-            w->deleteLater();
-        }
-        delete item;
-    }
-    m_choiceButtons.clear();
-    m_choiceRenderers.clear();
-    
-    QString imageBaseDir;
-    if (m_practiceManager) {
-        const QString typeDir = "TrueOrFalse";
-        const QString subjectPath = m_practiceManager->getCurrentSubjectPath();
-        if (!subjectPath.isEmpty()) {
-            imageBaseDir = QDir(subjectPath).filePath(typeDir);
-        } else {
-            const QString subjectName = m_practiceManager->getCurrentSession().subject;
-            imageBaseDir = QDir(QApplication::applicationDirPath()).filePath("Subject/" + subjectName + "/" + typeDir);
-        }
-    }
-
-    // 设置题目内容
-    m_questionTextRenderer->setContent(question.getQuestion(), question.getImages(), imageBaseDir);
+    Q_UNUSED(question)
     
-    // Create True/False buttons
-    QRadioButton *trueButton = new QRadioButton("A. 正确");
-    QRadioButton *falseButton = new QRadioButton("B. 错误");
-    
-    trueButton->setObjectName("choiceButton");
-    falseButton->setObjectName("choiceButton");
-    
-    m_choiceButtons.append(trueButton);
-    m_choiceButtons.append(falseButton);
-    
-    m_choiceButtonGroup->addButton(trueButton, 0);
-    m_choiceButtonGroup->addButton(falseButton, 1);
-    
-    m_choiceLayout->addWidget(trueButton);
-    m_choiceLayout->addWidget(falseButton);
-    m_choiceLayout->addStretch();
-    
-    connect(trueButton, &QRadioButton::toggled, this, &PracticeWidget::onChoiceSelected);
-    connect(falseButton, &QRadioButton::toggled, this, &PracticeWidget::onChoiceSelected);
+    m_choiceRow->hide();
+    m_trueFalsePanel->show();
+    bindChoiceButtons(m_trueFalseButtons);
 }
 
 void PracticeWidget::displayFillBlankQuestion(const Question &question)
 {
-    QString imageBaseDir;
-    if (m_practiceManager) {
-        const QString typeDir = "FillBlank";
-        const QString subjectPath = m_practiceManager->getCurrentSubjectPath();
-        if (!subjectPath.isEmpty()) {
-            imageBaseDir = QDir(subjectPath).filePath(typeDir);
-        } else {
-            const QString subjectName = m_practiceManager->getCurrentSession().subject;
-            imageBaseDir = QDir(QApplication::applicationDirPath()).filePath("Subject/" + subjectName + "/" + typeDir);
-        }
-    }
-
-    // 设置题目内容
-    m_questionTextRenderer->setContent(question.getQuestion(), question.getImages(), imageBaseDir);
-    
-    // Clear existing edits
-    for (QLineEdit *edit : m_fillBlankEdits) {
-        edit->deleteLater();
-    }
-    m_fillBlankEdits.clear();
-    
     int blankCount = question.getBlankNum();
     if (blankCount <= 0) {
         blankCount = 1; // At least one blank
     }
     
-    // Create fill blank edits
-    for (int i = 0; i < blankCount; ++i) {
-        QLabel *label = new QLabel(QString("第 %1 空:").arg(i + 1));
-        QLineEdit *edit = new QLineEdit();
-        edit->setPlaceholderText("请输入答案");
-        
-        m_fillBlankLayout->addWidget(label);
-        m_fillBlankLayout->addWidget(edit);
-        m_fillBlankEdits.append(edit);
-        
-        connect(edit, &QLineEdit::textChanged, this, &PracticeWidget::onFillBlankChanged);
+    ensureFillBlankInputs(blankCount);
+    for (int i = 0; i < m_fillBlankEditPool.size(); ++i) {
+        const bool visible = i < blankCount;
+        m_fillBlankLabelPool[i]->setVisible(visible);
+        m_fillBlankEditPool[i]->setVisible(visible);
     }
-    
-    m_fillBlankLayout->addStretch();
+    m_fillBlankEdits = m_fillBlankEditPool.mid(0, blankCount);
 }
 
 void PracticeWidget::displayMultiChoiceQuestion(const Question &question)
 {
-    // 清除旧的选项渲染器
-    for (auto renderer : m_choiceRenderers) {
-        renderer->deleteLater();
-    }
-    m_choiceRenderers.clear();
+    // 题干和选项已由renderQuestionContent渲染到页面中
+    const QStringList &choices = question.getChoices();
+    const int choiceCount = qMin(choices.size(), m_multiChoiceBoxPool.size());
     
-    QString imageBaseDir;
-    if (m_practiceManager) {
-        const QString typeDir = "MultiChoice";
-        const QString subjectPath = m_practiceManager->getCurrentSubjectPath();
-        if (!subjectPath.isEmpty()) {
-            imageBaseDir = QDir(subjectPath).filePath(typeDir);
-        } else {
-            const QString subjectName = m_practiceManager->getCurrentSession().subject;
-            imageBaseDir = QDir(QApplication::applicationDirPath()).filePath("Subject/" + subjectName + "/" + typeDir);
-        }
+    for (int i = 0; i < m_multiChoiceBoxPool.size(); ++i) {
+        m_multiChoiceBoxPool[i]->setVisible(i < choiceCount);
     }
+    m_multiChoiceBoxes = m_multiChoiceBoxPool.mid(0, choiceCount);
+}
 
-    // 设置题目内容
-    m_questionTextRenderer->setContent(question.getQuestion(), question.getImages(), imageBaseDir);
-    
-    QStringList choices = question.getChoices();
+void PracticeWidget::setupAnswerInputs()
+{
+    // 各题型的输入控件只创建一次，切换题目时按题目显示/隐藏
+    const QStringList labels = {"A", "B", "C", "D", "E", "F", "G", "H"};
     
-    // Clear existing checkboxes
-    for (QCheckBox *checkbox : m_multiChoiceBoxes) {
-        checkbox->deleteLater();
+    // 单选题：一行选项字母
+    m_choiceRow = new QWidget();
+    QHBoxLayout *buttonRow = new QHBoxLayout(m_choiceRow);
+    buttonRow->setContentsMargins(0, 0, 0, 0);
+    buttonRow->setSpacing(20);
+    for (const QString &label : labels) {
+        QRadioButton *radioButton = new QRadioButton(label);
+        radioButton->setObjectName("choiceButton");
+        buttonRow->addWidget(radioButton);
+        m_choiceButtonPool.append(radioButton);
+        connect(radioButton, &QRadioButton::toggled, this, &PracticeWidget::onChoiceSelected);
+    }
+    buttonRow->addStretch();
+    
+    // 判断题：正确/错误两个按钮
+    m_trueFalsePanel = new QWidget();
+    QVBoxLayout *trueFalseLayout = new QVBoxLayout(m_trueFalsePanel);
+    trueFalseLayout->setContentsMargins(0, 0, 0, 0);
+    for (const QString &text : {QString("A. 正确"), QString("B. 错误")}) {
+        QRadioButton *radioButton = new QRadioButton(text);
+        radioButton->setObjectName("choiceButton");
+        trueFalseLayout->addWidget(radioButton);
+        m_trueFalseButtons.append(radioButton);
+        connect(radioButton, &QRadioButton::toggled, this, &PracticeWidget::onChoiceSelected);
     }
-    m_multiChoiceBoxes.clear();
     
-    // Create new checkboxes
-    QStringList labels = {"A", "B", "C", "D", "E", "F", "G", "H"};
-    for (int i = 0; i < choices.size() && i < labels.size(); ++i) {
-        // 创建选项容器
-        QWidget *choiceContainer = new QWidget();
-        QHBoxLayout *choiceLayout = new QHBoxLayout(choiceContainer);
-        choiceLayout->setContentsMargins(0, 0, 0, 0);
-        choiceLayout->setSpacing(10);
-        
-        // 创建复选框
-        QCheckBox *checkbox = new QCheckBox(labels[i]);
-        checkbox->setFixedWidth(30);
+    m_choiceLayout->addWidget(m_choiceRow);
+    m_choiceLayout->addWidget(m_trueFalsePanel);
+    m_choiceLayout->addStretch();
+    m_choiceRow->hide();
+    m_trueFalsePanel->hide();
+    
+    // 多选题：一行复选框
+    QHBoxLayout *boxRow = new QHBoxLayout();
+    boxRow->setSpacing(20);
+    for (const QString &label : labels) {
+        QCheckBox *checkbox = new QCheckBox(label);
         checkbox->setObjectName("multiChoiceBox");
-        
-        // 创建选项内容渲染器
-        MarkdownRenderer *choiceRenderer = createChoiceRenderer(choices[i], question.getImages(), imageBaseDir);
-        
-        choiceLayout->addWidget(checkbox);
-        choiceLayout->addWidget(choiceRenderer, 1);
-        
-        m_multiChoiceLayout->addWidget(choiceContainer);
-        
-        m_multiChoiceBoxes.append(checkbox);
-        m_choiceRenderers.append(choiceRenderer);
+        boxRow->addWidget(checkbox);
+        m_multiChoiceBoxPool.append(checkbox);
         
         connect(checkbox, &QCheckBox::toggled, [this]() {
             bool hasSelection = false;
@@ -1173,85 +1106,190 @@ void PracticeWidget::displayMultiChoiceQuestion(const Question &question)
                 }
             }
             m_submitButton->setEnabled(hasSelection && !m_isAnswerSubmitted);
+            syncRendererChoiceSelection();
         });
     }
-    
+    boxRow->addStretch();
+    m_multiChoiceLayout->addLayout(boxRow);
     m_multiChoiceLayout->addStretch();
+    
+    // 填空题：空的数量不固定，先创建常用的数量，不够时再补充
+    m_fillBlankLayout->addStretch();
+    ensureFillBlankInputs(4);
 }
 
-void PracticeWidget::updateQuestionList()
+void PracticeWidget::ensureFillBlankInputs(int count)
+{
+    for (int i = m_fillBlankEditPool.size(); i < count; ++i) {
+        QLabel *label = new QLabel(QString("第 %1 空:").arg(i + 1));
+        QLineEdit *edit = new QLineEdit();
+        edit->setPlaceholderText("请输入答案");
+        
+        // 插入到末尾的弹性空间之前
+        m_fillBlankLayout->insertWidget(m_fillBlankLayout->count() - 1, label);
+        m_fillBlankLayout->insertWidget(m_fillBlankLayout->count() - 1, edit);
+        m_fillBlankLabelPool.append(label);
+        m_fillBlankEditPool.append(edit);
+        
+        connect(edit, &QLineEdit::textChanged, this, &PracticeWidget::onFillBlankChanged);
+    }
+}
+
+void PracticeWidget::bindChoiceButtons(const QVector<QRadioButton*> &buttons)
+{
+    // 按钮组中只保留当前题目使用的按钮，编号即选项序号
+    for (QAbstractButton *button : m_choiceButtonGroup->buttons()) {
+        m_choiceButtonGroup->removeButton(button);
+    }
+    for (int i = 0; i < buttons.size(); ++i) {
+        m_choiceButtonGroup->addButton(buttons[i], i);
+    }
+    m_choiceButtons = buttons;
+}
+
+QString PracticeWidget::questionImageBaseDir(const Question &question) const
 {
     if (!m_practiceManager) {
-        return;
+        return QString();
     }
     
-    // 保存当前选中项
-    int selectedRow = m_questionListWidget->currentRow();
+    QString typeDir;
+    switch (question.getType()) {
+        case QuestionType::Choice:
+            typeDir = "Choice";
+            break;
+        case QuestionType::TrueOrFalse:
+            typeDir = "TrueOrFalse";
+            break;
+        case QuestionType::FillBlank:
+            typeDir = "FillBlank";
+            break;
+        case QuestionType::MultipleChoice:
+            typeDir = "MultiChoice";
+            break;
+        default:
+            typeDir = "Choice";
+            break;
+    }
     
-    m_questionListWidget->clear();
+    const QString subjectPath = m_practiceManager->getCurrentSubjectPath();
+    if (!subjectPath.isEmpty()) {
+        return QDir(subjectPath).filePath(typeDir);
+    }
+    const QString subjectName = m_practiceManager->getCurrentSession().subject;
+    return QDir(QApplication::applicationDirPath()).filePath("Subject/" + subjectName + "/" + typeDir);
+}
+
+void PracticeWidget::renderQuestionContent(MarkdownRenderer *renderer, const Question &question) const
+{
+    const QString imageBaseDir = questionImageBaseDir(question);
     
-    int totalQuestions = m_practiceManager->getTotalQuestions();
-    for (int i = 0; i < totalQuestions; ++i) {
-        QListWidgetItem *item = new QListWidgetItem();
-        item->setData(Qt::UserRole, i);
-        
-        QString status;
-        QColor backgroundColor;
-        QColor textColor = QColor("black");
-        bool isBold = false;
-        
-        // 首先检查是否为当前题目
-        if (i == m_currentQuestionIndex) {
-            status = "●";
-            backgroundColor = QColor("#007bff");
-            textColor = QColor("black");
-            isBold = true;
-        }
-        // 然后检查答题状态
-        else if (m_practiceManager->getQuestionManager()->isAnswered(i)) {
-            // Check if answer was correct
-            bool correct = m_practiceManager->getQuestionManager()->checkAnswer(i);
-            status = correct ? "✓" : "✗";
-            backgroundColor = correct ? QColor("#d4edda") : QColor("#f8d7da");
-            textColor = correct ? QColor("#155724") : QColor("#721c24");
+    if (question.getType() == QuestionType::Choice || question.getType() == QuestionType::MultipleChoice) {
+        // 题干和全部选项渲染到同一个页面，避免每个选项各占一个WebEngine视图
+        const QStringList labels = {"A", "B", "C", "D", "E", "F", "G", "H"};
+        renderer->setQuestionContent(question.getQuestion(), question.getChoices(), labels,
+                                     question.getImages(), imageBaseDir);
+    } else {
+        renderer->setContent(question.getQuestion(), question.getImages(), imageBaseDir);
+    }
+}
+
+void PracticeWidget::schedulePrefetch()
+{
+    m_prefetchTimer->start();
+}
+
+void PracticeWidget::prefetchAdjacentQuestions()
+{
+    if (!m_practiceManager || m_currentQuestionIndex < 0) {
+        return;
+    }
+    
+    // 预取后两题和上一题，其余的归还对象池
+    const QVector<int> wanted = {m_currentQuestionIndex + 1, m_currentQuestionIndex + 2, m_currentQuestionIndex - 1};
+    for (auto it = m_prefetchedRenderers.begin(); it != m_prefetchedRenderers.end();) {
+        if (!wanted.contains(it.key())) {
+            MarkdownRendererPool::instance()->release(it.value());
+            it = m_prefetchedRenderers.erase(it);
         } else {
-            status = "○";
-            backgroundColor = QColor("white");
+            ++it;
         }
-        
-        item->setText(QString("%1 %2").arg(i + 1).arg(status));
-        
-        // 设置样式
-        item->setBackground(backgroundColor);
-        item->setForeground(textColor);
-        
-        if (isBold) {
-            QFont font = item->font();
-            font.setBold(true);
-            item->setFont(font);
-        }
-        
-        // 设置工具提示
-        QString tooltip;
-        if (i == m_currentQuestionIndex) {
-            tooltip = QString("当前题目 %1").arg(i + 1);
-        } else if (m_practiceManager->getQuestionManager()->isAnswered(i)) {
-            bool correct = m_practiceManager->getQuestionManager()->checkAnswer(i);
-            tooltip = QString("题目 %1 - %2").arg(i + 1).arg(correct ? "答对" : "答错");
-        } else {
-            tooltip = QString("题目 %1 - 未答").arg(i + 1);
+    }
+    
+    QuestionManager *questionManager = m_practiceManager->getQuestionManager();
+    for (int index : wanted) {
+        if (index < 0 || index >= m_totalQuestions || m_prefetchedRenderers.contains(index)) {
+            continue;
         }
-        item->setToolTip(tooltip);
         
-        m_questionListWidget->addItem(item);
+        // 渲染器不加入布局，保持隐藏；宽度与当前渲染器一致，换上时高度已经正确
+        MarkdownRenderer *renderer = MarkdownRendererPool::instance()->acquire(m_questionContent);
+        renderer->hide();
+        renderer->setAutoResize(true, 600);
+        renderer->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Minimum);
+        renderer->resize(m_questionTextRenderer->width(), renderer->height());
+        renderQuestionContent(renderer, questionManager->getQuestion(index));
+        m_prefetchedRenderers.insert(index, renderer);
+    }
+}
+
+bool PracticeWidget::activatePrefetchedRenderer(int index)
+{
+    MarkdownRenderer *renderer = m_prefetchedRenderers.take(index);
+    if (!renderer) {
+        return false;
     }
     
-    // 添加完所有项后，清除选中状态以避免与当前题目样式冲突
-    m_questionListWidget->setCurrentRow(-1);
+    MarkdownRenderer *previous = m_questionTextRenderer;
+    disconnect(previous, &MarkdownRenderer::choiceClicked, this, &PracticeWidget::onRendererChoiceClicked);
+    m_questionContentLayout->replaceWidget(previous, renderer);
+    previous->hide();
+    
+    // 刚才显示的题目通常仍在预取范围内（如翻到下一题后的上一题），先保留，超出范围的在下次预取时归还
+    if (m_displayedQuestionIndex >= 0 && !m_prefetchedRenderers.contains(m_displayedQuestionIndex)) {
+        m_prefetchedRenderers.insert(m_displayedQuestionIndex, previous);
+    } else {
+        MarkdownRendererPool::instance()->release(previous);
+    }
+    
+    m_questionTextRenderer = renderer;
+    connect(m_questionTextRenderer, &MarkdownRenderer::choiceClicked,
+            this, &PracticeWidget::onRendererChoiceClicked);
+    m_questionTextRenderer->setSelectedChoices(QList<int>());
+    m_questionTextRenderer->show();
+    return true;
+}
+
+void PracticeWidget::clearPrefetchedRenderers()
+{
+    if (m_prefetchTimer) {
+        m_prefetchTimer->stop();
+    }
+    const QList<MarkdownRenderer*> renderers = m_prefetchedRenderers.values();
+    for (MarkdownRenderer *renderer : renderers) {
+        MarkdownRendererPool::instance()->release(renderer);
+    }
+    m_prefetchedRenderers.clear();
+    m_displayedQuestionIndex = -1;
+}
+
+void PracticeWidget::updateQuestionList()
+{
+    if (!m_practiceManager) {
+        return;
+    }
     
+    // 重新关联题目数据，模型不逐行创建条目，视图只查询可见的行
+    m_questionListModel->reset(m_practiceManager->getQuestionManager(), m_currentQuestionIndex);
+    scrollToCurrentQuestion();
+}
+
+void PracticeWidget::scrollToCurrentQuestion()
+{
     // 确保当前题目可见
-    if (m_currentQuestionIndex >= 0 && m_currentQuestionIndex < totalQuestions) {
-        m_questionListWidget->scrollToItem(m_questionListWidget->item(m_currentQuestionIndex));
+    const int row = m_questionListModel->currentIndex();
+    if (row >= 0 && row < m_questionListModel->rowCount()) {
+        m_questionListView->scrollTo(m_questionListModel->index(row));
     }
 }
 
@@ -1283,46 +1321,33 @@ void PracticeWidget::updateStatistics()
 
 void PracticeWidget::clearAnswerInputs()
 {
-    // Clear choice renderers
-    for (auto renderer : m_choiceRenderers) {
-        renderer->deleteLater();
+    // 输入控件常驻复用，这里只清除上一题的选择和输入，不触发作答相关的信号
+    // 互斥的按钮组不能取消选中，需要临时关闭互斥
+    m_choiceButtonGroup->setExclusive(false);
+    for (QRadioButton *button : m_choiceButtonPool + m_trueFalseButtons) {
+        const QSignalBlocker blocker(button);
+        button->setChecked(false);
     }
-    m_choiceRenderers.clear();
+    m_choiceButtonGroup->setExclusive(true);
     
-    // Clear choice buttons
-    for (QRadioButton *button : m_choiceButtons) {
-        m_choiceButtonGroup->removeButton(button);
-        button->deleteLater();
+    for (QCheckBox *checkbox : m_multiChoiceBoxPool) {
+        const QSignalBlocker blocker(checkbox);
+        checkbox->setChecked(false);
     }
-    m_choiceButtons.clear();
     
-    // Clear multi-choice boxes
-    for (QCheckBox *checkbox : m_multiChoiceBoxes) {
-        checkbox->deleteLater();
+    for (QLineEdit *edit : m_fillBlankEditPool) {
+        const QSignalBlocker blocker(edit);
+        edit->clear();
     }
-    m_multiChoiceBoxes.clear();
     
-    // Clear fill blank edits
-    for (QLineEdit *edit : m_fillBlankEdits) {
-        edit->deleteLater();
-    }
+    m_choiceButtons.clear();
+    m_multiChoiceBoxes.clear();
     m_fillBlankEdits.clear();
-    
-    // Clear layouts
-    QLayoutItem *item;
-    while ((item = m_choiceLayout->takeAt(0)) != nullptr) {
-        delete item;
-    }
-    while ((item = m_multiChoiceLayout->takeAt(0)) != nullptr) {
-        delete item;
-    }
-    while ((item = m_fillBlankLayout->takeAt(0)) != nullptr) {
-        delete item;
-    }
 }
 
 void PracticeWidget::setAnswerInputsEnabled(bool enabled)
 {
+    m_questionTextRenderer->setChoicesEnabled(enabled);
     for (QRadioButton *button : m_choiceButtons) {
         button->setEnabled(enabled);
     }
@@ -1564,15 +1589,6 @@ void PracticeWidget::restoreUserAnswer()
     }
 }
 
-MarkdownRenderer* PracticeWidget::createChoiceRenderer(const QString &choiceText, const QMap<QString, QString> &images, const QString &imageBaseDir)
-{
-    MarkdownRenderer *renderer = new MarkdownRenderer(this);
-    renderer->setAutoResize(true, 0);
-    renderer->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Minimum);
-    renderer->setContent(choiceText, images, imageBaseDir);
-    return renderer;
-}
-
 void PracticeWidget::hideAnswerResult()
 {
     if (m_resultFrame) {
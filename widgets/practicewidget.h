@@ -16,14 +16,14 @@
 #include <QSplitter>
 #include <QProgressBar>
 #include <QTimer>
-#include <QListWidget>
-#include <QListWidgetItem>
+#include <QListView>
 #include <QButtonGroup>
 #include <QStackedWidget>
 #include <QFrame>
 #include <QKeyEvent>
 #include <QShortcut>
 #include <QMap>
+#include <QHash>
 #include "../models/question.h"
 #include "../utils/markdownrenderer.h"  // 新增
 
@@ -42,8 +42,8 @@ class QScrollArea;
 class QSplitter;
 class QProgressBar;
 class QTimer;
-class QListWidget;
-class QListWidgetItem;
+class QListView;
+class QModelIndex;
 class QButtonGroup;
 class QStackedWidget;
 class QFrame;
@@ -51,6 +51,7 @@ class QShortcut;
 QT_END_NAMESPACE
 
 class PracticeManager;
+class QuestionListModel;
 enum class QuestionType;
 
 class PracticeWidget : public QWidget
@@ -83,9 +84,10 @@ private slots:
     void onPauseClicked();
     void onFinishClicked();
     void onBackClicked();  // 处理返回按钮点击
-    void onQuestionListItemClicked(QListWidgetItem *item);
+    void onQuestionListItemClicked(const QModelIndex &index);
     
     void onChoiceSelected();
+    void onRendererChoiceClicked(int index);
     void onFillBlankChanged();
     void updateTimer();
 
@@ -104,6 +106,7 @@ private:
     
     void updateQuestionDisplay();
     void updateQuestionList();
+    void scrollToCurrentQuestion();
     void updateNavigationButtons();
     void updateStatistics();
     void clearAnswerInputs();
@@ -114,8 +117,23 @@ private:
     void displayFillBlankQuestion(const Question &question);
     void displayMultiChoiceQuestion(const Question &question);
     
-    // 新增：创建选项渲染器
-    MarkdownRenderer* createChoiceRenderer(const QString &choiceText, const QMap<QString, QString> &images, const QString &imageBaseDir);
+    // 答案输入控件按题型常驻，切换题目时只显示/隐藏
+    void setupAnswerInputs();
+    void ensureFillBlankInputs(int count);
+    void bindChoiceButtons(const QVector<QRadioButton*> &buttons);
+    
+    // 题目内容（题干、选项和图片）渲染，当前题目和预取的题目共用
+    QString questionImageBaseDir(const Question &question) const;
+    void renderQuestionContent(MarkdownRenderer *renderer, const Question &question) const;
+    
+    // 预取：提前把相邻题目渲染到隐藏的渲染器中，切换题目时直接替换
+    void schedulePrefetch();
+    void prefetchAdjacentQuestions();
+    bool activatePrefetchedRenderer(int index);
+    void clearPrefetchedRenderers();
+    
+    // 将选项按钮的选中状态同步到题目页面中的选项高亮
+    void syncRendererChoiceSelection();
     
     QString getCurrentAnswer() const;
     QStringList getCurrentAnswers() const;
@@ -153,18 +171,24 @@ private:
     QWidget *m_choiceWidget;
     QVBoxLayout *m_choiceLayout;
     QButtonGroup *m_choiceButtonGroup;
-    QVector<QRadioButton*> m_choiceButtons;
-    QVector<MarkdownRenderer*> m_choiceRenderers;  // 新增：选项渲染器
+    QVector<QRadioButton*> m_choiceButtons;         // 当前题目使用的按钮
+    QWidget *m_choiceRow;                           // 单选题的选项字母按钮
+    QWidget *m_trueFalsePanel;                      // 判断题的正确/错误按钮
+    QVector<QRadioButton*> m_choiceButtonPool;
+    QVector<QRadioButton*> m_trueFalseButtons;
     
     // Multi-Choice Question Widgets
     QWidget *m_multiChoiceWidget;
     QVBoxLayout *m_multiChoiceLayout;
-    QVector<QCheckBox*> m_multiChoiceBoxes;
+    QVector<QCheckBox*> m_multiChoiceBoxes;         // 当前题目使用的复选框
+    QVector<QCheckBox*> m_multiChoiceBoxPool;
     
     // Fill Blank Question Widgets
     QWidget *m_fillBlankWidget;
     QVBoxLayout *m_fillBlankLayout;
-    QVector<QLineEdit*> m_fillBlankEdits;
+    QVector<QLineEdit*> m_fillBlankEdits;           // 当前题目使用的输入框
+    QVector<QLabel*> m_fillBlankLabelPool;
+    QVector<QLineEdit*> m_fillBlankEditPool;
     
     // Answer Result Display
     QFrame *m_resultFrame;
@@ -198,7 +222,8 @@ private:
     // Question List Group
     QGroupBox *m_questionListGroup;
     QVBoxLayout *m_questionListLayout;
-    QListWidget *m_questionListWidget;
+    QListView *m_questionListView;
+    QuestionListModel *m_questionListModel;
     
     // Control Buttons
     QHBoxLayout *m_controlLayout;
@@ -213,6 +238,11 @@ private:
     bool m_isPaused;
     QuestionType m_currentQuestionType;
     
+    // Prefetch
+    QTimer *m_prefetchTimer;
+    QHash<int, MarkdownRenderer*> m_prefetchedRenderers;  // 题目序号 -> 已渲染好的隐藏渲染器
+    int m_displayedQuestionIndex;                         // m_questionTextRenderer当前显示的题目
+    
     // Shortcuts
     QShortcut *m_shortcutA;
     QShortcut *m_shortcutB;
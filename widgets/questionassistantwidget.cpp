@@ -97,7 +97,7 @@ void QuestionAssistantWidget::setConfigManager(ConfigManager *configManager)
         connect(m_topKSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int v) {
             if (!m_configManager) return;
             m_configManager->setAssistantSearchTopK(v);
-            m_configManager->saveConfig();
+            m_configManager->scheduleSave();
         }, Qt::UniqueConnection);
     }
     if (m_ptaTopKSpinBox) {
@@ -105,7 +105,7 @@ void QuestionAssistantWidget::setConfigManager(ConfigManager *configManager)
         connect(m_ptaTopKSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int v) {
             if (!m_configManager) return;
             m_configManager->setAssistantSearchTopK(v);
-            m_configManager->saveConfig();
+            m_configManager->scheduleSave();
         }, Qt::UniqueConnection);
     }
     if (m_ptaThresholdSpinBox) {
@@ -113,14 +113,20 @@ void QuestionAssistantWidget::setConfigManager(ConfigManager *configManager)
         connect(m_ptaThresholdSpinBox, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, [this](double v) {
             if (!m_configManager) return;
             m_configManager->setAssistantAutoThreshold(v);
-            m_configManager->saveConfig();
+            m_configManager->scheduleSave();
         }, Qt::UniqueConnection);
     }
 }
 
 bool QuestionAssistantWidget::prepareForShow()
 {
-    return ensureIndexReady(true);
+    // 题库未变化时直接复用已有索引，变化由BankWatcher/配置界面通知
+    return ensureIndexReady(false);
+}
+
+void QuestionAssistantWidget::markIndexStale()
+{
+    m_indexStale = true;
 }
 
 void QuestionAssistantWidget::setupUI()
@@ -809,7 +815,7 @@ void QuestionAssistantWidget::log(const QString &msg)
 
 bool QuestionAssistantWidget::ensureIndexReady(bool forceRebuild)
 {
-    if (!forceRebuild && m_searchIndex->isReady()) {
+    if (!forceRebuild && !m_indexStale && m_searchIndex->isReady()) {
         return true;
     }
     if (!m_configManager) {
@@ -823,6 +829,7 @@ bool QuestionAssistantWidget::ensureIndexReady(bool forceRebuild)
         return false;
     }
 
+    m_indexStale = false;
     m_indexStatusLabel->setText(QString("题库索引：已加载 %1 题").arg(m_searchIndex->documentCount()));
     return true;
 }
@@ -58,6 +58,7 @@ public:
 
     void setConfigManager(ConfigManager *configManager);
     bool prepareForShow();
+    void markIndexStale();
 
 signals:
     void backRequested();
@@ -121,6 +122,7 @@ protected:
     QString m_currentPtaId;
     QHash<QString, ParsedPtaQuestion> m_ptaQuestions;
     QHash<QString, PtaCacheEntry> m_ptaCache;
+    bool m_indexStale = true;
     bool m_ptaAutoRunning = false;
     QStringList m_ptaAutoQueue;
     int m_ptaAutoPos = 0;
@@ -1,6 +1,7 @@
 #include "questionpreviewwidget.h"
 
 #include "../utils/markdownrenderer.h"
+#include "../utils/markdownrendererpool.h"
 
 #include <QLabel>
 #include <QVBoxLayout>
@@ -47,7 +48,7 @@ void QuestionPreviewWidget::setupUI()
     m_contentLayout->setContentsMargins(8, 8, 8, 8);
     m_contentLayout->setSpacing(12);
 
-    m_questionRenderer = new MarkdownRenderer(m_scrollContent);
+    m_questionRenderer = MarkdownRendererPool::instance()->acquire(m_scrollContent);
     m_questionRenderer->setAutoResize(true, 1000); // 增加最大高度限制，避免过早截断
 
     m_choicesContainer = new QWidget(m_scrollContent);
@@ -98,13 +99,7 @@ void QuestionPreviewWidget::clear()
     m_answerContentLabel->setText("-");
     m_questionRenderer->setContent("");
 
-    while (m_choicesLayout->count() > 0) {
-        QLayoutItem *item = m_choicesLayout->takeAt(0);
-        if (item && item->widget()) {
-            item->widget()->deleteLater();
-        }
-        delete item;
-    }
+    releaseChoiceRenderers();
 }
 
 static QString questionTypeToText(QuestionType t)
@@ -138,13 +133,7 @@ QString QuestionPreviewWidget::buildAnswerText(const Question &question) const
 
 void QuestionPreviewWidget::rebuildChoices(const Question &question)
 {
-    while (m_choicesLayout->count() > 0) {
-        QLayoutItem *item = m_choicesLayout->takeAt(0);
-        if (item && item->widget()) {
-            item->widget()->deleteLater();
-        }
-        delete item;
-    }
+    releaseChoiceRenderers();
 
     const QStringList choices = question.getChoices();
     if (choices.isEmpty()) {
@@ -154,11 +143,26 @@ void QuestionPreviewWidget::rebuildChoices(const Question &question)
 
     m_choicesContainer->setVisible(true);
     for (const QString &c : choices) {
-        MarkdownRenderer *r = new MarkdownRenderer(m_choicesContainer);
+        MarkdownRenderer *r = MarkdownRendererPool::instance()->acquire(m_choicesContainer);
         r->setAutoResize(true, 1000); // 增加选项渲染高度限制
         r->setContent(c, question.getImages());
         r->setStyleSheet("MarkdownRenderer { border: 1px solid #eee; border-radius: 4px; padding: 4px; background: #fff; }");
         m_choicesLayout->addWidget(r);
+        m_choiceRenderers.append(r);
+    }
+}
+
+void QuestionPreviewWidget::releaseChoiceRenderers()
+{
+    // 选项渲染器归还对象池，下次预览时直接复用
+    for (MarkdownRenderer *r : m_choiceRenderers) {
+        m_choicesLayout->removeWidget(r);
+        MarkdownRendererPool::instance()->release(r);
+    }
+    m_choiceRenderers.clear();
+
+    while (m_choicesLayout->count() > 0) {
+        delete m_choicesLayout->takeAt(0);
     }
 }
 
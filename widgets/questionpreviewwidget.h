@@ -2,6 +2,7 @@
 #define QUESTIONPREVIEWWIDGET_H
 
 #include <QWidget>
+#include <QVector>
 
 #include "../models/question.h"
 
@@ -25,6 +26,7 @@ public:
 private:
     void setupUI();
     void rebuildChoices(const Question &question);
+    void releaseChoiceRenderers();
     QString buildAnswerText(const Question &question) const;
 
     QVBoxLayout *m_mainLayout;
@@ -35,6 +37,7 @@ private:
     MarkdownRenderer *m_questionRenderer;
     QWidget *m_choicesContainer;
     QVBoxLayout *m_choicesLayout;
+    QVector<MarkdownRenderer*> m_choiceRenderers;  // 从对象池取出的选项渲染器
     
     // 答案区域
     QWidget *m_answerContainer;
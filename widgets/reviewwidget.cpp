@@ -4,6 +4,7 @@
 #include "../models/question.h"
 #include "../utils/jsonutils.h"
 #include "../utils/markdownrenderer.h"
+#include "../utils/markdownrendererpool.h"
 #include <QSplitter>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -68,12 +69,6 @@ void ReviewWidget::setConfigManager(ConfigManager *configManager)
 void ReviewWidget::setPracticeManager(PracticeManager *practiceManager)
 {
     m_practiceManager = practiceManager;
-    
-    // 连接错题导入请求信号
-    if (m_practiceManager) {
-        connect(m_practiceManager, &PracticeManager::wrongAnswersImportRequested,
-                this, &ReviewWidget::onWrongAnswersImportRequested);
-    }
 }
 
 void ReviewWidget::loadWrongAnswers()
@@ -309,20 +304,20 @@ void ReviewWidget::setupUI()
     m_detailSubjectLabel->setObjectName("detailSubject");
     m_detailTypeLabel = new QLabel();
     m_detailTypeLabel->setObjectName("detailType");
-    m_detailQuestionRenderer = new MarkdownRenderer();
+    m_detailQuestionRenderer = MarkdownRendererPool::instance()->acquire(m_detailsContent);
     m_detailQuestionRenderer->setObjectName("detailQuestion");
     m_detailQuestionRenderer->setAutoResize(true, 400);  // 启用自动适配
     m_detailImageLabel = new QLabel();
     m_detailImageLabel->setAlignment(Qt::AlignCenter);
     m_detailImageLabel->setScaledContents(false);
     m_detailImageLabel->setVisible(false);
-    m_detailChoicesRenderer = new MarkdownRenderer();
+    m_detailChoicesRenderer = MarkdownRendererPool::instance()->acquire(m_detailsContent);
     m_detailChoicesRenderer->setObjectName("detailChoices");
     m_detailChoicesRenderer->setAutoResize(true, 300);  // 启用自动适配
-    m_detailCorrectAnswerRenderer = new MarkdownRenderer();
+    m_detailCorrectAnswerRenderer = MarkdownRendererPool::instance()->acquire(m_detailsContent);
     m_detailCorrectAnswerRenderer->setObjectName("detailCorrectAnswer");
     m_detailCorrectAnswerRenderer->setAutoResize(true, 200);  // 启用自动适配
-    m_detailUserAnswerRenderer = new MarkdownRenderer();
+    m_detailUserAnswerRenderer = MarkdownRendererPool::instance()->acquire(m_detailsContent);
     m_detailUserAnswerRenderer->setObjectName("detailUserAnswer");
     m_detailUserAnswerRenderer->setAutoResize(true, 200);  // 启用自动适配
     m_detailTimestampLabel = new QLabel();
@@ -54,6 +54,10 @@ public:
     void setWrongAnswerSet(WrongAnswerSet *wrongAnswerSet);
     WrongAnswerSet* getWrongAnswerSet() const;
     
+public slots:
+    // 错题导入询问处理（由主窗口转发PracticeManager的请求，复习界面可能尚未创建）
+    void onWrongAnswersImportRequested(const QList<Question> &wrongQuestions, const QString &subject);
+    
 signals:
     void backRequested();
     void startReviewRequested(const QList<Question> &questions);
@@ -80,8 +84,6 @@ private slots:
     void onBackClicked();
     void onRefreshClicked();
     
-    // 错题导入询问处理
-    void onWrongAnswersImportRequested(const QList<Question> &wrongQuestions, const QString &subject);
 private:
     void setupUI();
     void setupConnections();
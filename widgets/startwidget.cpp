@@ -21,6 +21,7 @@ StartWidget::StartWidget(QWidget *parent)
     : QWidget(parent)
     , m_configManager(nullptr)
     , m_hasCheckpoint(false)
+    , m_buttonStatesPending(false)
 {
     setupUI();
     setupConnections();
@@ -35,6 +36,13 @@ StartWidget::~StartWidget()
 void StartWidget::setConfigManager(ConfigManager *configManager)
 {
     m_configManager = configManager;
+    // 按钮状态需要科目列表，会加载并扫描题库，由主窗口在开始界面显示之后调用loadButtonStates()
+    m_buttonStatesPending = true;
+}
+
+void StartWidget::loadButtonStates()
+{
+    m_buttonStatesPending = false;
     updateButtonStates();
 }
 
@@ -415,7 +423,11 @@ void StartWidget::checkForCheckpoint()
 {
     if (m_configManager) {
         m_hasCheckpoint = m_configManager->hasCheckpoint();
-        updateButtonStates();
+        if (m_buttonStatesPending) {
+            m_resumeButton->setVisible(m_hasCheckpoint);
+        } else {
+            updateButtonStates();
+        }
     }
 }
 
@@ -37,6 +37,8 @@ protected:
 
 public:
     void checkForCheckpoint();
+    // 根据科目列表更新按钮状态（需要加载题库，启动时由主窗口推迟调用）
+    void loadButtonStates();
 
 private slots:
     void onStartPracticeClicked();
@@ -88,6 +90,7 @@ private:
     // Data
     ConfigManager *m_configManager;
     bool m_hasCheckpoint;
+    bool m_buttonStatesPending;     // 尚未调用loadButtonStates()
 };
 
 #endif // STARTWIDGET_H